@@ -34,7 +34,8 @@ void AddSystem::redo()
     // previous system if possible.
     if (myIndex > 0)
     {
-        const System &prevSystem = myScore.getSystems()[myIndex - 1];
+        const Score &score = myScore;
+        const System &prevSystem = score.getSystems()[myIndex - 1];
         KeySignature key = prevSystem.getBarlines().back().getKeySignature();
         TimeSignature time = prevSystem.getBarlines().back().getTimeSignature();
 
@@ -0,0 +1,29 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef ACTIONS_COMMANDIDS_H
+#define ACTIONS_COMMANDIDS_H
+
+/// Ids for the undo commands that can be merged with QUndoCommand::mergeWith().
+/// QUndoStack only merges consecutive commands that have the same id, so each
+/// mergeable command must have its own value here.
+enum CommandId
+{
+    EditTabNumberId = 1
+};
+
+#endif
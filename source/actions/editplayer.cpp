@@ -35,8 +35,14 @@ void EditPlayer::redo()
     {
         // If the number of strings changed, remove the player from any staves
         // it was assigned to.
-        for (System &system : myScore.getSystems())
+        const Score &score = myScore;
+        for (size_t s = 0; s < score.getSystems().size(); ++s)
         {
+            // Avoid detaching systems that aren't modified.
+            if (score.getSystems()[s].getPlayerChanges().empty())
+                continue;
+
+            System &system = myScore.getSystems()[s];
             for (PlayerChange &change : system.getPlayerChanges())
             {
                 myOriginalChanges.push_back(change);
@@ -65,8 +71,14 @@ void EditPlayer::undo()
     if (!myOriginalChanges.empty())
     {
         int i = 0;
-        for (System &system : myScore.getSystems())
+        const Score &score = myScore;
+        for (size_t s = 0; s < score.getSystems().size(); ++s)
         {
+            // Avoid detaching systems that aren't modified.
+            if (score.getSystems()[s].getPlayerChanges().empty())
+                continue;
+
+            System &system = myScore.getSystems()[s];
             for (PlayerChange &change : system.getPlayerChanges())
             {
                 change = myOriginalChanges[i];
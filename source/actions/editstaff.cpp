@@ -18,6 +18,7 @@
 #include "editstaff.h"
 
 #include <score/score.h>
+#include <score/utils/memoryusage.h>
 
 EditStaff::EditStaff(const ScoreLocation &location, Staff::ClefType clef,
     int strings)
@@ -66,6 +67,16 @@ void EditStaff::redo()
 
         staff.setStringCount(myNumStrings);
     }
+
+    // Redoing the command stores the same systems again, so the estimate only
+    // needs to be computed once.
+    if (!myMemoryUsage)
+    {
+        myMemoryUsage = ScoreUtils::estimateMemoryUsage(myOriginalSystem);
+        if (myOriginalNextSystem)
+            *myMemoryUsage +=
+                ScoreUtils::estimateMemoryUsage(*myOriginalNextSystem);
+    }
 }
 
 void EditStaff::undo()
@@ -78,6 +89,11 @@ void EditStaff::undo()
         score.getSystems()[system_index + 1] = *myOriginalNextSystem;
 }
 
+size_t EditStaff::getMemoryUsage() const
+{
+    return myMemoryUsage.get_value_or(0);
+}
+
 void EditStaff::addPlayerChangeAtStart(Score &score, int system_index)
 {
     System &system = score.getSystems()[system_index];
@@ -18,12 +18,13 @@
 #ifndef ACTIONS_EDITCLEF_H
 #define ACTIONS_EDITCLEF_H
 
+#include <actions/undomemoryusage.h>
 #include <boost/optional.hpp>
 #include <QUndoCommand>
 #include <score/scorelocation.h>
 #include <score/system.h>
 
-class EditStaff : public QUndoCommand
+class EditStaff : public QUndoCommand, public UndoMemoryUsage
 {
 public:
     EditStaff(const ScoreLocation &location, Staff::ClefType clef, int strings);
@@ -31,6 +32,8 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    virtual size_t getMemoryUsage() const override;
+
 private:
     static void addPlayerChangeAtStart(Score &score, int system_index);
 
@@ -39,6 +42,9 @@ private:
     boost::optional<System> myOriginalNextSystem;
     Staff::ClefType myClef;
     int myNumStrings;
+    /// Estimated size of the original systems, computed when they are first
+    /// stored.
+    boost::optional<size_t> myMemoryUsage;
 };
 
 #endif
@@ -17,6 +17,8 @@
   
 #include "edittabnumber.h"
 
+#include <actions/commandids.h>
+
 EditTabNumber::EditTabNumber(const ScoreLocation &location, int typedNumber)
     : QUndoCommand(QObject::tr("Edit Tab Number")),
       myLocation(location),
@@ -52,6 +54,30 @@ void EditTabNumber::redo()
     }
 }
 
+int EditTabNumber::id() const
+{
+    return EditTabNumberId;
+}
+
+bool EditTabNumber::mergeWith(const QUndoCommand *other)
+{
+    auto cmd = static_cast<const EditTabNumber *>(other);
+    const ScoreLocation &location = cmd->myLocation;
+
+    if (location.getSystemIndex() != myLocation.getSystemIndex() ||
+        location.getStaffIndex() != myLocation.getStaffIndex() ||
+        location.getVoiceIndex() != myLocation.getVoiceIndex() ||
+        location.getPositionIndex() != myLocation.getPositionIndex() ||
+        location.getString() != myLocation.getString() ||
+        cmd->myTappedHarmonicOffset != myTappedHarmonicOffset)
+    {
+        return false;
+    }
+
+    myNewNumber = cmd->myNewNumber;
+    return true;
+}
+
 void EditTabNumber::undo()
 {
     myLocation.getNote()->setFretNumber(myOriginalNumber);
@@ -30,6 +30,11 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    /// Consecutive edits to the same note (e.g. typing a double digit fret
+    /// number) are merged into a single command.
+    virtual int id() const override;
+    virtual bool mergeWith(const QUndoCommand *other) override;
+
 private:
     ScoreLocation myLocation;
     const int myOriginalNumber;
@@ -70,17 +70,15 @@ InsertNotes::InsertNotes(const ScoreLocation &location,
 void InsertNotes::redo()
 {
     // Shift existing notes / barlines to the right if necessary.
-    for (int i = 0; i < myShiftAmount; ++i)
+    if (myShiftAmount > 0)
     {
-        SystemUtils::shiftForward(myLocation.getSystem(),
-                                  myLocation.getPositionIndex());
+        SystemUtils::shift(myLocation.getSystem(),
+                           myLocation.getPositionIndex(), myShiftAmount);
     }
 
     // Insert the new items.
-    for (const Position &pos : myNewPositions)
-        myLocation.getVoice().insertPosition(pos);
-    for (const IrregularGrouping &group : myNewGroups)
-        myLocation.getVoice().insertIrregularGrouping(group);
+    myLocation.getVoice().insertPositions(myNewPositions);
+    myLocation.getVoice().insertIrregularGroupings(myNewGroups);
 }
 
 void InsertNotes::undo()
@@ -93,9 +91,9 @@ void InsertNotes::undo()
         myLocation.getVoice().removeIrregularGrouping(group);
 
     // Undo any shifting that was performed.
-    for (int i = 0; i < myShiftAmount; ++i)
+    if (myShiftAmount > 0)
     {
-        SystemUtils::shiftBackward(myLocation.getSystem(),
-                                   myLocation.getPositionIndex());
+        SystemUtils::shift(myLocation.getSystem(),
+                           myLocation.getPositionIndex(), -myShiftAmount);
     }
 }
@@ -17,7 +17,7 @@
   
 #include "polishscore.h"
 
-#include <score/score.h>
+#include <score/system.h>
 #include <score/utils/scorepolisher.h>
 
 PolishScore::PolishScore(Score &score)
@@ -27,16 +27,17 @@ PolishScore::PolishScore(Score &score)
 
 void PolishScore::redo()
 {
-    for (const System &system : myScore.getSystems())
-        myOriginalSystems.push_back(system);
-
-    ScoreUtils::polishScore(myScore);
+    myDelta.apply(myScore, [](System &system) {
+        ScoreUtils::polishSystem(system);
+    });
 }
 
 void PolishScore::undo()
 {
-    std::copy(myOriginalSystems.begin(), myOriginalSystems.end(),
-              myScore.getSystems().begin());
+    myDelta.restore(myScore);
+}
 
-    myOriginalSystems.clear();
+size_t PolishScore::getMemoryUsage() const
+{
+    return myDelta.getMemoryUsage();
 }
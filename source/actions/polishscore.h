@@ -18,12 +18,13 @@
 #ifndef ACTIONS_POLISHSCORE_H
 #define ACTIONS_POLISHSCORE_H
 
+#include <actions/systemdelta.h>
+#include <actions/undomemoryusage.h>
 #include <QUndoCommand>
-#include <score/system.h>
 
 class Score;
 
-class PolishScore : public QUndoCommand
+class PolishScore : public QUndoCommand, public UndoMemoryUsage
 {
 public:
     PolishScore(Score &score);
@@ -31,9 +32,12 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    virtual size_t getMemoryUsage() const override;
+
 private:
     Score &myScore;
-    std::vector<System> myOriginalSystems;
+    /// The original contents of the systems that were reformatted.
+    SystemDelta myDelta;
 };
 
 #endif
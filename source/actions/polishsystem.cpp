@@ -26,12 +26,16 @@ PolishSystem::PolishSystem(const ScoreLocation &location)
 
 void PolishSystem::redo()
 {
-    myOriginalSystem = myLocation.getSystem();
-    ScoreUtils::polishSystem(myLocation.getSystem());
+    myDelta.apply(myLocation.getScore(), myLocation.getSystemIndex(),
+                  [](System &system) { ScoreUtils::polishSystem(system); });
 }
 
 void PolishSystem::undo()
 {
-    myLocation.getSystem() = *myOriginalSystem;
-    myOriginalSystem.reset();
+    myDelta.restore(myLocation.getScore());
+}
+
+size_t PolishSystem::getMemoryUsage() const
+{
+    return myDelta.getMemoryUsage();
 }
@@ -20,11 +20,11 @@
 
 #include <QUndoCommand>
 
-#include <boost/optional/optional.hpp>
+#include <actions/systemdelta.h>
+#include <actions/undomemoryusage.h>
 #include <score/scorelocation.h>
-#include <score/system.h>
 
-class PolishSystem : public QUndoCommand
+class PolishSystem : public QUndoCommand, public UndoMemoryUsage
 {
 public:
     PolishSystem(const ScoreLocation &location);
@@ -32,9 +32,11 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    virtual size_t getMemoryUsage() const override;
+
 private:
     ScoreLocation myLocation;
-    boost::optional<System> myOriginalSystem;
+    SystemDelta myDelta;
 };
 
 #endif
@@ -33,8 +33,14 @@ void RemovePlayer::redo()
 
     // Remove the player from any player changes that it was involved in.
     myOriginalChanges.clear();
-    for (System &system : myScore.getSystems())
+    const Score &score = myScore;
+    for (size_t s = 0; s < score.getSystems().size(); ++s)
     {
+        // Avoid detaching systems that aren't modified.
+        if (score.getSystems()[s].getPlayerChanges().empty())
+            continue;
+
+        System &system = myScore.getSystems()[s];
         for (PlayerChange &change : system.getPlayerChanges())
         {
             myOriginalChanges.push_back(change);
@@ -69,8 +75,14 @@ void RemovePlayer::undo()
 
     // Restore the original player changes.
     int i = 0;
-    for (System &system : myScore.getSystems())
+    const Score &score = myScore;
+    for (size_t s = 0; s < score.getSystems().size(); ++s)
     {
+        // Avoid detaching systems that aren't modified.
+        if (score.getSystems()[s].getPlayerChanges().empty())
+            continue;
+
+        System &system = myScore.getSystems()[s];
         for (PlayerChange &change : system.getPlayerChanges())
         {
             change = myOriginalChanges[i];
@@ -18,12 +18,14 @@
 #include "removesystem.h"
 
 #include <score/score.h>
+#include <score/utils/memoryusage.h>
 
 RemoveSystem::RemoveSystem(Score &score, int index)
     : QUndoCommand(QObject::tr("Remove System")),
       myScore(score),
       myIndex(index),
-      myOriginalSystem(score.getSystems()[index])
+      myOriginalSystem(static_cast<const Score &>(score).getSystems()[index]),
+      myMemoryUsage(ScoreUtils::estimateMemoryUsage(myOriginalSystem))
 {
 }
 
@@ -36,3 +38,8 @@ void RemoveSystem::undo()
 {
     myScore.insertSystem(myOriginalSystem, myIndex);
 }
+
+size_t RemoveSystem::getMemoryUsage() const
+{
+    return myMemoryUsage;
+}
@@ -18,12 +18,13 @@
 #ifndef ACTIONS_REMOVESYSTEM_H
 #define ACTIONS_REMOVESYSTEM_H
 
+#include <actions/undomemoryusage.h>
 #include <QUndoCommand>
 #include <score/system.h>
 
 class Score;
 
-class RemoveSystem : public QUndoCommand
+class RemoveSystem : public QUndoCommand, public UndoMemoryUsage
 {
 public:
     RemoveSystem(Score &score, int index);
@@ -31,10 +32,13 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    virtual size_t getMemoryUsage() const override;
+
 private:
     Score &myScore;
     const int myIndex;
     const System myOriginalSystem;
+    const size_t myMemoryUsage;
 };
 
 #endif
@@ -0,0 +1,220 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "scorechange.h"
+
+#include <algorithm>
+
+ScoreChange::IndexSet::IndexSet() : myAll(false)
+{
+}
+
+bool ScoreChange::IndexSet::isEmpty() const
+{
+    return !myAll && myIndices.empty();
+}
+
+bool ScoreChange::IndexSet::contains(int index) const
+{
+    return myAll ||
+           std::binary_search(myIndices.begin(), myIndices.end(), index);
+}
+
+void ScoreChange::IndexSet::insert(int index)
+{
+    if (myAll)
+        return;
+
+    auto it = std::lower_bound(myIndices.begin(), myIndices.end(), index);
+    if (it == myIndices.end() || *it != index)
+        myIndices.insert(it, index);
+}
+
+void ScoreChange::IndexSet::merge(const IndexSet &other)
+{
+    if (other.myAll)
+        setAll();
+    else
+    {
+        for (int index : other.myIndices)
+            insert(index);
+    }
+}
+
+void ScoreChange::IndexSet::setAll()
+{
+    myAll = true;
+    myIndices.clear();
+}
+
+bool ScoreChange::IndexSet::operator==(const IndexSet &other) const
+{
+    return myAll == other.myAll && myIndices == other.myIndices;
+}
+
+ScoreChange::ScoreChange() : myProperties(NoProperties)
+{
+}
+
+ScoreChange ScoreChange::system(int index)
+{
+    ScoreChange change;
+    change.mySystems.insert(index);
+    return change;
+}
+
+ScoreChange ScoreChange::allSystems()
+{
+    ScoreChange change;
+    change.mySystems.setAll();
+    return change;
+}
+
+ScoreChange ScoreChange::player(int index)
+{
+    ScoreChange change;
+    change.myPlayers.insert(index);
+    return change;
+}
+
+ScoreChange ScoreChange::allPlayers()
+{
+    ScoreChange change;
+    change.myPlayers.setAll();
+    return change;
+}
+
+ScoreChange ScoreChange::instrument(int index)
+{
+    ScoreChange change;
+    change.myInstruments.insert(index);
+    return change;
+}
+
+ScoreChange ScoreChange::allInstruments()
+{
+    ScoreChange change;
+    change.myInstruments.setAll();
+    return change;
+}
+
+ScoreChange ScoreChange::properties(ScoreProperty properties)
+{
+    ScoreChange change;
+    change.myProperties = properties;
+    return change;
+}
+
+ScoreChange ScoreChange::everything()
+{
+    return allSystems() | allPlayers() | allInstruments() |
+           properties(AllProperties);
+}
+
+ScoreChange &ScoreChange::operator|=(const ScoreChange &other)
+{
+    mySystems.merge(other.mySystems);
+    myPlayers.merge(other.myPlayers);
+    myInstruments.merge(other.myInstruments);
+    myProperties |= other.myProperties;
+    return *this;
+}
+
+ScoreChange ScoreChange::operator|(const ScoreChange &other) const
+{
+    ScoreChange change(*this);
+    change |= other;
+    return change;
+}
+
+bool ScoreChange::operator==(const ScoreChange &other) const
+{
+    return mySystems == other.mySystems && myPlayers == other.myPlayers &&
+           myInstruments == other.myInstruments &&
+           myProperties == other.myProperties;
+}
+
+bool ScoreChange::isEmpty() const
+{
+    return mySystems.isEmpty() && myPlayers.isEmpty() &&
+           myInstruments.isEmpty() && myProperties == NoProperties;
+}
+
+bool ScoreChange::affectsAnySystem() const
+{
+    return !mySystems.isEmpty();
+}
+
+bool ScoreChange::affectsAllSystems() const
+{
+    return mySystems.myAll;
+}
+
+bool ScoreChange::affectsSystem(int index) const
+{
+    return mySystems.contains(index);
+}
+
+const std::vector<int> &ScoreChange::getSystems() const
+{
+    return mySystems.myIndices;
+}
+
+bool ScoreChange::affectsAnyPlayer() const
+{
+    return !myPlayers.isEmpty();
+}
+
+bool ScoreChange::affectsAllPlayers() const
+{
+    return myPlayers.myAll;
+}
+
+bool ScoreChange::affectsPlayer(int index) const
+{
+    return myPlayers.contains(index);
+}
+
+const std::vector<int> &ScoreChange::getPlayers() const
+{
+    return myPlayers.myIndices;
+}
+
+bool ScoreChange::affectsAnyInstrument() const
+{
+    return !myInstruments.isEmpty();
+}
+
+bool ScoreChange::affectsAllInstruments() const
+{
+    return myInstruments.myAll;
+}
+
+bool ScoreChange::affectsInstrument(int index) const
+{
+    return myInstruments.contains(index);
+}
+
+const std::vector<int> &ScoreChange::getInstruments() const
+{
+    return myInstruments.myIndices;
+}
+
+bool ScoreChange::affectsProperty(ScoreProperty property) const
+{
+    return (myProperties & property) != 0;
+}
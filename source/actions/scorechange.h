@@ -0,0 +1,111 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef ACTIONS_SCORECHANGE_H
+#define ACTIONS_SCORECHANGE_H
+
+#include <vector>
+
+/// Describes which parts of a score were modified by an edit, so that data
+/// computed from the score (e.g. layout, or the order in which the bars are
+/// played) can be updated precisely instead of being rebuilt entirely.
+class ScoreChange
+{
+public:
+    /// Properties of the score that aren't part of a system, player, or
+    /// instrument.
+    enum ScoreProperty
+    {
+        NoProperties = 0,
+        ScoreInfo = 1 << 0,
+        ViewFilters = 1 << 1,
+        LineSpacing = 1 << 2,
+        AllProperties = ScoreInfo | ViewFilters | LineSpacing
+    };
+
+    /// Creates an empty change.
+    ScoreChange();
+
+    /// The contents of a single system were modified.
+    static ScoreChange system(int index);
+    /// Any of the systems may have been modified, inserted, or removed.
+    static ScoreChange allSystems();
+    /// A single player was modified.
+    static ScoreChange player(int index);
+    /// Any of the players may have been modified, inserted, or removed.
+    static ScoreChange allPlayers();
+    /// A single instrument was modified.
+    static ScoreChange instrument(int index);
+    /// Any of the instruments may have been modified, inserted, or removed.
+    static ScoreChange allInstruments();
+    /// Properties of the score, such as its information or view filters.
+    static ScoreChange properties(ScoreProperty properties);
+    /// Anything in the score may have been modified.
+    static ScoreChange everything();
+
+    /// Combines the changes (e.g. for a sequence of edits).
+    ScoreChange &operator|=(const ScoreChange &other);
+    ScoreChange operator|(const ScoreChange &other) const;
+
+    bool operator==(const ScoreChange &other) const;
+
+    bool isEmpty() const;
+
+    bool affectsAnySystem() const;
+    bool affectsAllSystems() const;
+    bool affectsSystem(int index) const;
+    /// Returns the modified systems, in increasing order. This is only
+    /// meaningful if affectsAllSystems() is false.
+    const std::vector<int> &getSystems() const;
+
+    bool affectsAnyPlayer() const;
+    bool affectsAllPlayers() const;
+    bool affectsPlayer(int index) const;
+    const std::vector<int> &getPlayers() const;
+
+    bool affectsAnyInstrument() const;
+    bool affectsAllInstruments() const;
+    bool affectsInstrument(int index) const;
+    const std::vector<int> &getInstruments() const;
+
+    bool affectsProperty(ScoreProperty property) const;
+
+private:
+    /// A set of indices, or every index.
+    struct IndexSet
+    {
+        IndexSet();
+
+        bool isEmpty() const;
+        bool contains(int index) const;
+        void insert(int index);
+        void merge(const IndexSet &other);
+        void setAll();
+
+        bool operator==(const IndexSet &other) const;
+
+        bool myAll;
+        std::vector<int> myIndices;
+    };
+
+    IndexSet mySystems;
+    IndexSet myPlayers;
+    IndexSet myInstruments;
+    int myProperties;
+};
+
+#endif
@@ -0,0 +1,97 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "systemdelta.h"
+
+#include <memory>
+#include <score/score.h>
+#include <score/utils/memoryusage.h>
+#include <score/utils/parallelsystems.h>
+
+SystemDelta::SystemDelta() : myMemoryUsage(0)
+{
+}
+
+void SystemDelta::apply(Score &score, const EditFunction &edit)
+{
+    const Score &const_score = score;
+    std::vector<std::unique_ptr<System>> changes(score.getSystems().size());
+
+    // Edit copies of the systems without modifying the score, so that
+    // unchanged systems stay shared with any other copies of the score (e.g.
+    // the MIDI player's). Actions are run from the GUI thread, so all of the
+    // cores can be used.
+    ScoreUtils::forEachSystem(
+        const_score,
+        [&](int i, const System &system) {
+            std::unique_ptr<System> edited(new System(system));
+            edit(*edited);
+
+            if (!(*edited == system))
+                changes[i] = std::move(edited);
+        },
+        ScoreUtils::ParallelOptions::allThreads());
+
+    // Swap in the changed systems, and record the originals in order.
+    for (int i = 0; i < static_cast<int>(changes.size()); ++i)
+    {
+        if (changes[i])
+        {
+            System &system = score.getSystems()[i];
+            std::swap(system, *changes[i]);
+            myMemoryUsage += ScoreUtils::estimateMemoryUsage(*changes[i]);
+            myOriginalSystems.emplace_back(i, std::move(*changes[i]));
+        }
+    }
+}
+
+void SystemDelta::apply(Score &score, int systemIndex, const EditFunction &edit)
+{
+    const Score &const_score = score;
+    const System &original = const_score.getSystems()[systemIndex];
+
+    // Edit a copy of the system, and keep the original only if something
+    // actually changed.
+    System edited(original);
+    edit(edited);
+
+    if (!(edited == original))
+    {
+        std::swap(score.getSystems()[systemIndex], edited);
+        myMemoryUsage += ScoreUtils::estimateMemoryUsage(edited);
+        myOriginalSystems.emplace_back(systemIndex, std::move(edited));
+    }
+}
+
+void SystemDelta::restore(Score &score)
+{
+    for (auto &entry : myOriginalSystems)
+        score.getSystems()[entry.first] = std::move(entry.second);
+
+    myOriginalSystems.clear();
+    myMemoryUsage = 0;
+}
+
+size_t SystemDelta::getChangedSystemCount() const
+{
+    return myOriginalSystems.size();
+}
+
+size_t SystemDelta::getMemoryUsage() const
+{
+    return myMemoryUsage;
+}
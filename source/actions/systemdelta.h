@@ -0,0 +1,59 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef ACTIONS_SYSTEMDELTA_H
+#define ACTIONS_SYSTEMDELTA_H
+
+#include <functional>
+#include <score/system.h>
+#include <utility>
+#include <vector>
+
+class Score;
+
+/// Records the original contents of the systems that are modified by an
+/// action. Only the systems that actually changed are stored, rather than a
+/// copy of the whole score.
+class SystemDelta
+{
+public:
+    SystemDelta();
+
+    typedef std::function<void(System &)> EditFunction;
+
+    /// Applies the edit to each system in the score. The systems are edited
+    /// in parallel, so the edit must only modify the system that it is given.
+    void apply(Score &score, const EditFunction &edit);
+    /// Applies the edit to a single system.
+    void apply(Score &score, int systemIndex, const EditFunction &edit);
+
+    /// Restores the original contents of the modified systems.
+    void restore(Score &score);
+
+    /// Returns the number of systems that were modified.
+    size_t getChangedSystemCount() const;
+    /// Returns an estimate of the number of bytes used by the stored systems.
+    size_t getMemoryUsage() const;
+
+private:
+    std::vector<std::pair<int, System>> myOriginalSystems;
+    /// The memory usage is computed when the systems are recorded, since the
+    /// undo manager may query it frequently.
+    size_t myMemoryUsage;
+};
+
+#endif
@@ -17,9 +17,69 @@
 
 #include "undomanager.h"
 
+#include <actions/undomemoryusage.h>
+
+static size_t getCommandMemoryUsage(const QUndoCommand *cmd);
+
+/// Wraps an undo command, and reports the modified parts of the score after
+/// the command is redone or undone.
+class RedrawCommand : public QUndoCommand, public UndoMemoryUsage
+{
+public:
+    RedrawCommand(QUndoCommand *cmd, const ScoreChange &change,
+                  UndoManager &manager)
+        : QUndoCommand(cmd->text()),
+          myCommand(cmd),
+          myChange(change),
+          myManager(manager)
+    {
+    }
+
+    virtual void redo() override
+    {
+        myCommand->redo();
+        myManager.onScoreChanged(myChange);
+    }
+
+    virtual void undo() override
+    {
+        myCommand->undo();
+        myManager.onScoreChanged(myChange);
+    }
+
+    virtual int id() const override
+    {
+        return myCommand->id();
+    }
+
+    virtual bool mergeWith(const QUndoCommand *other) override
+    {
+        // The stack only merges commands that have the same id, and every
+        // command pushed through the UndoManager is wrapped.
+        auto cmd = static_cast<const RedrawCommand *>(other);
+
+        return cmd->myChange == myChange &&
+               myCommand->mergeWith(cmd->myCommand.get());
+    }
+
+    virtual size_t getMemoryUsage() const override
+    {
+        return sizeof(*this) + getCommandMemoryUsage(myCommand.get());
+    }
+
+private:
+    std::unique_ptr<QUndoCommand> myCommand;
+    const ScoreChange myChange;
+    UndoManager &myManager;
+};
+
 UndoManager::UndoManager(QObject *parent) :
-    QUndoGroup(parent)
+    QUndoGroup(parent),
+    myMemoryLimit(0),
+    myMacroDepth(0)
 {
+    connect(this, &QUndoGroup::cleanChanged, this,
+            [this]() { emit modifiedChanged(isModified()); });
 }
 
 void UndoManager::addNewUndoStack()
@@ -39,77 +99,158 @@ void UndoManager::setActiveStackIndex(int index)
 void UndoManager::removeStack(int index)
 {
     // Stack is automatically removed from the QUndoGroup when it is deleted.
+    myStacksWithDiscardedChanges.erase(undoStacks.at(index).get());
+    myMemoryUsage.erase(undoStacks.at(index).get());
     undoStacks.erase(undoStacks.begin() + index);
 }
 
 void UndoManager::push(QUndoCommand *cmd)
 {
     activeStack()->push(cmd);
+
+    // Commands within a macro are added to the macro's command, which is
+    // estimated once the macro is finished.
+    if (myMacroDepth == 0)
+        updateMemoryUsage();
 }
 
 void UndoManager::push(QUndoCommand *cmd, int affectedSystem)
 {
-    beginMacro(cmd->actionText());
+    push(cmd, affectedSystem == AFFECTS_ALL_SYSTEMS
+                  ? ScoreChange::allSystems()
+                  : ScoreChange::system(affectedSystem));
+}
 
-    auto onUndo = new SignalOnUndo();
-    if (affectedSystem >= 0)
-    {
-        connect(onUndo, &SignalOnUndo::triggered, [=]() {
-            onSystemChanged(affectedSystem);
-        });
-    }
-    else
-    {
-        connect(onUndo, &SignalOnUndo::triggered, this,
-                &UndoManager::fullRedrawNeeded);
-    }
+void UndoManager::push(QUndoCommand *cmd, const ScoreChange &change)
+{
+    // Commands within a macro can't be discarded until it is finished. The
+    // limit is checked before pushing the new command so that it can always
+    // be undone, even if it alone exceeds the limit.
+    if (myMacroDepth == 0)
+        enforceMemoryLimit();
 
-    push(onUndo);
-    push(cmd);
+    push(new RedrawCommand(cmd, change, *this));
+}
+
+void UndoManager::setClean()
+{
+    myStacksWithDiscardedChanges.erase(activeStack());
+    activeStack()->setClean();
 
-    auto onRedo = new SignalOnRedo();
-    if (affectedSystem >= 0)
+    // The stack may already have been clean if its history was discarded.
+    emit modifiedChanged(isModified());
+}
+
+bool UndoManager::isModified() const
+{
+    const QUndoStack *stack = activeStack();
+    if (!stack)
+        return false;
+
+    return !stack->isClean() || myStacksWithDiscardedChanges.count(stack);
+}
+
+void UndoManager::onScoreChanged(const ScoreChange &change)
+{
+    emit scoreChanged(change);
+
+    // Changes to the players, instruments, etc. can affect the layout of any
+    // system (e.g. a new tuning), so the whole score is redrawn.
+    if (change.affectsAllSystems() || change.affectsAnyPlayer() ||
+        change.affectsAnyInstrument() ||
+        change.affectsProperty(ScoreChange::AllProperties))
     {
-        connect(onRedo, &SignalOnRedo::triggered, [=]() {
-            onSystemChanged(affectedSystem);
-        });
+        emit fullRedrawNeeded();
     }
     else
     {
-        connect(onRedo, &SignalOnRedo::triggered, this,
-                &UndoManager::fullRedrawNeeded);
+        for (int system : change.getSystems())
+            emit redrawNeeded(system);
     }
+}
 
-    push(onRedo);
-    endMacro();
+void UndoManager::beginMacro(const QString &text)
+{
+    activeStack()->beginMacro(text);
+    ++myMacroDepth;
 }
 
-void UndoManager::setClean()
+void UndoManager::endMacro()
 {
-    activeStack()->setClean();
+    activeStack()->endMacro();
+    --myMacroDepth;
+
+    if (myMacroDepth == 0)
+        updateMemoryUsage();
 }
 
-void UndoManager::onSystemChanged(int affectedSystem)
+void UndoManager::setMemoryLimit(size_t bytes)
 {
-    emit redrawNeeded(affectedSystem);
+    myMemoryLimit = bytes;
 }
 
-void UndoManager::beginMacro(const QString &text)
+static size_t getCommandMemoryUsage(const QUndoCommand *cmd)
 {
-    activeStack()->beginMacro(text);
+    size_t bytes = 0;
+    if (auto usage = dynamic_cast<const UndoMemoryUsage *>(cmd))
+        bytes += usage->getMemoryUsage();
+    else
+        bytes += sizeof(QUndoCommand);
+
+    for (int i = 0; i < cmd->childCount(); ++i)
+        bytes += getCommandMemoryUsage(cmd->child(i));
+
+    return bytes;
 }
 
-void UndoManager::endMacro()
+size_t UndoManager::getMemoryUsage() const
 {
-    activeStack()->endMacro();
+    auto it = myMemoryUsage.find(activeStack());
+    return it != myMemoryUsage.end() ? it->second.myTotal : 0;
 }
 
-void SignalOnRedo::redo()
+void UndoManager::updateMemoryUsage()
 {
-    emit triggered();
+    const QUndoStack *stack = activeStack();
+    StackMemoryUsage &usage = myMemoryUsage[stack];
+
+    // Pushing a command deletes any commands that had been undone, and then
+    // either appends the new command or merges it into the previous command.
+    // Either way, only the command at the top of the stack needs a new
+    // estimate.
+    const size_t count = stack->count();
+    while (!usage.myCommands.empty() && usage.myCommands.size() >= count)
+    {
+        usage.myTotal -= usage.myCommands.back();
+        usage.myCommands.pop_back();
+    }
+
+    if (count > 0)
+    {
+        const size_t bytes = getCommandMemoryUsage(stack->command(count - 1));
+        usage.myCommands.push_back(bytes);
+        usage.myTotal += bytes;
+    }
+    emit memoryUsageChanged();
 }
 
-void SignalOnUndo::undo()
+void UndoManager::enforceMemoryLimit()
 {
-    emit triggered();
+    QUndoStack *stack = activeStack();
+    if (myMemoryLimit == 0 || !stack)
+        return;
+
+    // QUndoStack can't remove individual commands, so the entire history is
+    // discarded. Clearing the stack also makes it clean, so if the document
+    // has unsaved changes it must still be reported as modified afterwards.
+    if (getMemoryUsage() > myMemoryLimit)
+    {
+        if (!stack->isClean())
+            myStacksWithDiscardedChanges.insert(stack);
+
+        myMemoryUsage.erase(stack);
+        stack->clear();
+        emit historyDiscarded();
+        emit memoryUsageChanged();
+    }
 }
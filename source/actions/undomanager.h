@@ -19,11 +19,15 @@
 #define ACTIONS_UNDOMANAGER_H
 
 #include <memory>
+#include <actions/scorechange.h>
 #include <QUndoGroup>
 #include <QUndoStack>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class QUndoCommand;
+class RedrawCommand;
 
 class UndoManager : public QUndoGroup
 {
@@ -36,51 +40,86 @@ public:
     void setActiveStackIndex(int index);
     void removeStack(int index);
 
-    /// Pushes an undo command onto the active stack.
+    /// Pushes an undo command onto the active stack. Consecutive commands
+    /// are merged if they affect the same system and the command supports
+    /// QUndoCommand::mergeWith().
     /// @param affectedSystem Index of the system that is modified by this action.
     /// Use -1 for actions that affect all systems.
     void push(QUndoCommand *cmd, int affectedSystem);
+    /// Pushes an undo command that modifies the given parts of the score.
+    void push(QUndoCommand *cmd, const ScoreChange &change);
 
     void setClean();
 
+    /// Returns whether the active document has been modified since it was
+    /// last saved. Unlike QUndoStack::isClean(), this takes into account any
+    /// changes whose history was discarded due to the memory limit.
+    bool isModified() const;
+
     void beginMacro(const QString &text);
     void endMacro();
 
+    /// Sets the approximate number of bytes that the history of each undo
+    /// stack may use. If this is exceeded, the older history is discarded
+    /// when the next action is performed, so that action can still be undone.
+    /// A limit of zero disables this.
+    void setMemoryLimit(size_t bytes);
+
+    /// Returns an estimate of the number of bytes used by the commands in the
+    /// active undo stack. This is a running total that is updated as commands
+    /// are pushed, so it is cheap to call.
+    size_t getMemoryUsage() const;
+
     static const int AFFECTS_ALL_SYSTEMS = -1;
 
 signals:
     void fullRedrawNeeded();
     void redrawNeeded(int);
+    /// Emitted after a command is done or undone, before the redraw signals.
+    void scoreChanged(const ScoreChange &change);
+    /// Emitted when the result of isModified() may have changed, e.g. after
+    /// an action or when the active stack changes.
+    void modifiedChanged(bool modified);
+    /// Emitted when the history of the active stack is discarded because it
+    /// exceeded the memory limit.
+    void historyDiscarded();
+    /// Emitted when the result of getMemoryUsage() may have changed for the
+    /// active stack, i.e. after a command is pushed or the history is
+    /// discarded. Undoing or redoing a command does not change it.
+    void memoryUsageChanged();
 
 private:
+    friend class RedrawCommand;
+
     /// Pushes the QUndoCommand onto the active stack.
     void push(QUndoCommand *cmd);
 
-    void onSystemChanged(int affectedSystem);
-
-    std::vector<std::unique_ptr<QUndoStack>> undoStacks;
-};
-
-class SignalOnRedo : public QObject, public QUndoCommand
-{
-    Q_OBJECT
+    /// Emits the change notification, and the appropriate redraw signals.
+    void onScoreChanged(const ScoreChange &change);
 
-public:
-    virtual void redo() override;
+    /// Updates the memory usage of the active stack after a command has been
+    /// pushed onto it (or a macro has been finished).
+    void updateMemoryUsage();
 
-signals:
-    void triggered();
-};
+    /// Discards the active stack's history if it exceeds the memory limit.
+    void enforceMemoryLimit();
 
-class SignalOnUndo: public QObject, public QUndoCommand
-{
-    Q_OBJECT
+    /// The estimated memory usage of each command in a stack, and their total.
+    struct StackMemoryUsage
+    {
+        StackMemoryUsage() : myTotal(0) {}
 
-public:
-    virtual void undo() override;
+        std::vector<size_t> myCommands;
+        size_t myTotal;
+    };
 
-signals:
-    void triggered();
+    std::vector<std::unique_ptr<QUndoStack>> undoStacks;
+    /// Stacks whose history was discarded while the document had unsaved
+    /// changes. These remain modified until the document is saved.
+    std::unordered_set<const QUndoStack *> myStacksWithDiscardedChanges;
+    std::unordered_map<const QUndoStack *, StackMemoryUsage> myMemoryUsage;
+    size_t myMemoryLimit;
+    int myMacroDepth;
 };
 
 #endif
@@ -0,0 +1,35 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef ACTIONS_UNDOMEMORYUSAGE_H
+#define ACTIONS_UNDOMEMORYUSAGE_H
+
+#include <cstddef>
+
+/// Implemented by undo commands that store a copy of part of the score (e.g.
+/// the original contents of a system), so that the undo manager can limit the
+/// amount of memory used by the undo history.
+class UndoMemoryUsage
+{
+public:
+    virtual ~UndoMemoryUsage() {}
+
+    /// Returns an estimate of the number of bytes stored by the command.
+    virtual size_t getMemoryUsage() const = 0;
+};
+
+#endif
@@ -56,7 +56,7 @@ void Caret::moveHorizontal(int offset)
 
 void Caret::moveVertical(int offset)
 {
-    const int numStrings = myLocation.getStaff().getStringCount();
+    const int numStrings = getConstLocation().getStaff().getStringCount();
     myLocation.setString((myLocation.getString() + offset + numStrings) %
                          numStrings);
 
@@ -96,7 +96,7 @@ void Caret::moveStaff(int offset)
 void Caret::moveToStaff(int staff)
 {
     const int num_staves =
-        static_cast<int>(myLocation.getSystem().getStaves().size());
+        static_cast<int>(getConstLocation().getSystem().getStaves().size());
     staff = boost::algorithm::clamp(staff, 0, num_staves - 1);
 
     const bool is_increasing = staff >= myLocation.getStaffIndex();
@@ -124,13 +124,13 @@ void Caret::moveToStaff(int staff)
 
 bool Caret::moveToNextBar()
 {
-    const Barline *nextBar = myLocation.getSystem().getNextBarline(
+    const Barline *nextBar = getConstLocation().getSystem().getNextBarline(
                 myLocation.getPositionIndex());
     if (!nextBar)
         return false;
 
     // Move into the next system if necessary.
-    if (*nextBar == myLocation.getSystem().getBarlines().back())
+    if (*nextBar == getConstLocation().getSystem().getBarlines().back())
         return moveToSystem(myLocation.getSystemIndex() + 1, true);
     else
     {
@@ -141,7 +141,7 @@ bool Caret::moveToNextBar()
 
 void Caret::moveToPrevBar()
 {
-    const System &system = myLocation.getSystem();
+    const System &system = getConstLocation().getSystem();
     const Barline *prevBar = system.getPreviousBarline(
                 myLocation.getPositionIndex());
     if (prevBar)
@@ -155,7 +155,7 @@ void Caret::moveToPrevBar()
         moveToSystem(myLocation.getSystemIndex() - 1, true);
 
         // Move to the last barline if possible.
-        const System &newSystem = myLocation.getSystem();
+        const System &newSystem = getConstLocation().getSystem();
         const size_t count = newSystem.getBarlines().size();
         if (count > 2)
             moveToPosition(newSystem.getBarlines()[count - 2].getPosition());
@@ -168,6 +168,11 @@ boost::signals2::connection Caret::subscribeToChanges(
     return onLocationChanged.connect(subscriber);
 }
 
+const ScoreLocation &Caret::getConstLocation() const
+{
+    return myLocation;
+}
+
 int Caret::getLastPosition() const
 {
     // There must be at least one position space to the left of the last bar.
@@ -200,9 +205,10 @@ bool Caret::moveToSystem(int system, bool keepStaff)
             myLocation.setStaffIndex(0);
         else
         {
+            const int num_staves = static_cast<int>(
+                getConstLocation().getSystem().getStaves().size());
             myLocation.setStaffIndex(boost::algorithm::clamp(
-                myLocation.getStaffIndex(), 0,
-                static_cast<int>(myLocation.getSystem().getStaves().size() - 1)));
+                myLocation.getStaffIndex(), 0, num_staves - 1));
         }
 
         myLocation.setPositionIndex(0);
@@ -218,11 +224,33 @@ bool Caret::moveToSystem(int system, bool keepStaff)
 
 void Caret::moveToLocation(const ScoreLocation &location)
 {
-    myLocation.setSystemIndex(location.getSystemIndex());
-    myLocation.setStaffIndex(location.getStaffIndex());
-    myLocation.setPositionIndex(location.getPositionIndex());
-    myLocation.setSelectionStart(location.getSelectionStart());
-    myLocation.setString(location.getString());
+    // The location might be from an older version of the score (e.g. where
+    // playback was started), so stay at the current location if its system
+    // was removed, and otherwise clamp it to the current score.
+    const int system_index = location.getSystemIndex();
+    if (system_index < 0 || system_index > getLastSystemIndex())
+        return;
+
+    const System &system =
+        getConstLocation().getScore().getSystems()[system_index];
+    const int num_staves = static_cast<int>(system.getStaves().size());
+    if (num_staves == 0)
+        return;
+
+    myLocation.setSystemIndex(system_index);
+    myLocation.setStaffIndex(
+        boost::algorithm::clamp(location.getStaffIndex(), 0, num_staves - 1));
+
+    const int last_position = getLastPosition();
+    myLocation.setPositionIndex(boost::algorithm::clamp(
+        location.getPositionIndex(), 0, last_position));
+    myLocation.setSelectionStart(boost::algorithm::clamp(
+        location.getSelectionStart(), 0, last_position));
+
+    const int num_strings =
+        system.getStaves()[myLocation.getStaffIndex()].getStringCount();
+    myLocation.setString(
+        boost::algorithm::clamp(location.getString(), 0, num_strings - 1));
 
     onLocationChanged();
 }
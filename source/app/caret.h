@@ -76,7 +76,8 @@ public:
     /// previous system if necessary.
     void moveToPrevBar();
 
-    /// Moves to the specified location.
+    /// Moves to the specified location, clamping it to the current score. If
+    /// its system no longer exists, the caret is not moved.
     void moveToLocation(const ScoreLocation &location);
 
     /// Ensures that the caret is still at a valid position.
@@ -90,6 +91,10 @@ private:
     /// Move to the specified staff.
     void moveToStaff(int staff);
 
+    /// Provides read-only access to the location from non-const methods, so
+    /// that moving the caret never detaches a system that is shared with
+    /// another copy of the score (e.g. the MIDI player's).
+    const ScoreLocation &getConstLocation() const;
     /// Returns the last valid position in the system.
     int getLastPosition() const;
     /// Returns the last valid system index in the score.
@@ -17,8 +17,15 @@
   
 #include "documentmanager.h"
 
+#include <actions/scorechange.h>
 #include <app/settings.h>
 #include <app/settingsmanager.h>
+#include <chrono>
+#include <iostream>
+#include <midi/midifile.h>
+#include <midi/performanceorder.h>
+#include <midi/playbacktimeline.h>
+#include <score/utils/navigationindex.h>
 
 DocumentManager::DocumentManager()
 {
@@ -137,10 +144,16 @@ int DocumentManager::findDocument(const Document::PathType &filepath)
 }
 
 Document::Document()
-    : myCaret(myScore, myViewOptions)
+    : myCaret(myScore, myViewOptions), myTimelineRevision(0), myRevision(0)
 {
 }
 
+Document::~Document()
+{
+    if (myTimelineThread.joinable())
+        myTimelineThread.join();
+}
+
 bool Document::hasFilename() const
 {
     return myFilename.is_initialized();
@@ -186,3 +199,162 @@ Caret &Document::getCaret()
 {
     return myCaret;
 }
+
+std::shared_ptr<const PerformanceOrder> Document::getPerformanceOrder() const
+{
+    if (!myPerformanceOrder)
+        myPerformanceOrder = std::make_shared<PerformanceOrder>(myScore);
+
+    return myPerformanceOrder;
+}
+
+std::shared_ptr<const PerformanceOrder> Document::findPerformanceOrder() const
+{
+    // Collect the order from a finished background computation.
+    if (!myPerformanceOrder)
+        findPlaybackTimeline();
+
+    // Otherwise, it can be computed directly once every system is loaded.
+    if (!myPerformanceOrder && myScore.getUnloadedSystemCount() == 0)
+        myPerformanceOrder = std::make_shared<PerformanceOrder>(myScore);
+
+    return myPerformanceOrder;
+}
+
+static std::shared_ptr<const PlaybackTimeline> computePlaybackTimeline(
+    const Score &score, const PerformanceOrder &order)
+{
+    // Generating the MIDI events is the simplest way to find the duration of
+    // each bar, taking into account e.g. multi-bar rests and tempo changes.
+    MidiFile file;
+    file.load(score, order, MidiFile::LoadOptions());
+
+    return std::make_shared<PlaybackTimeline>(order, file);
+}
+
+std::shared_ptr<const PlaybackTimeline> Document::getPlaybackTimeline() const
+{
+    // If the timeline is already being computed for this revision, wait for
+    // it rather than starting again.
+    if (!myPlaybackTimeline && myTimelineResult.valid() &&
+        myTimelineRevision == myRevision)
+    {
+        collectPlaybackTimeline();
+    }
+
+    if (!myPlaybackTimeline)
+    {
+        myPlaybackTimeline =
+            computePlaybackTimeline(myScore, *getPerformanceOrder());
+    }
+
+    return myPlaybackTimeline;
+}
+
+std::shared_ptr<const PlaybackTimeline> Document::findPlaybackTimeline() const
+{
+    if (!myPlaybackTimeline && myTimelineResult.valid() &&
+        myTimelineResult.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready)
+    {
+        collectPlaybackTimeline();
+    }
+
+    return myPlaybackTimeline;
+}
+
+bool Document::updatePlaybackTimelineAsync()
+{
+    if (findPlaybackTimeline())
+        return false;
+
+    // Only one computation runs at a time. If it is for an older revision, a
+    // new one is started once it finishes.
+    if (myTimelineResult.valid())
+        return true;
+
+    // Don't keep retrying if the timeline can't be computed for this score.
+    if (myFailedTimelineRevision == myRevision)
+        return false;
+
+    // Copying the score is cheap, since the systems are shared until they are
+    // modified. Systems that haven't been loaded yet are loaded by the copy
+    // on the background thread.
+    auto score = std::make_shared<const Score>(myScore);
+
+    std::promise<TimelineResult> promise;
+    myTimelineResult = promise.get_future();
+    myTimelineRevision = myRevision;
+
+    myTimelineThread = std::thread(
+        [score](std::promise<TimelineResult> result) {
+            try
+            {
+                TimelineResult value;
+                value.myOrder = std::make_shared<PerformanceOrder>(*score);
+                value.myTimeline =
+                    computePlaybackTimeline(*score, *value.myOrder);
+                result.set_value(std::move(value));
+            }
+            catch (...)
+            {
+                result.set_exception(std::current_exception());
+            }
+        },
+        std::move(promise));
+
+    return true;
+}
+
+void Document::collectPlaybackTimeline() const
+{
+    myTimelineThread.join();
+
+    TimelineResult result;
+    try
+    {
+        result = myTimelineResult.get();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error computing the playback timeline: " << e.what()
+                  << std::endl;
+        myFailedTimelineRevision = myTimelineRevision;
+        return;
+    }
+
+    if (myTimelineRevision == myRevision)
+    {
+        myPlaybackTimeline = result.myTimeline;
+        if (!myPerformanceOrder)
+            myPerformanceOrder = result.myOrder;
+    }
+}
+
+std::shared_ptr<const NavigationIndex> Document::getNavigationIndex() const
+{
+    if (!myNavigationIndex)
+        myNavigationIndex = std::make_shared<NavigationIndex>(myScore);
+
+    return myNavigationIndex;
+}
+
+void Document::notifyChanged(const ScoreChange &change)
+{
+    if (change.isEmpty())
+        return;
+
+    ++myRevision;
+
+    // The bar order, timeline, and navigation index only depend on the
+    // contents of the systems, so edits to e.g. a player's settings or the
+    // score information can keep them.
+    if (change.affectsAnySystem())
+    {
+        myPerformanceOrder.reset();
+        myPlaybackTimeline.reset();
+        myNavigationIndex.reset();
+    }
+
+    myChangePubSub.publish(myRevision, change);
+}
@@ -20,12 +20,19 @@
 
 #include <app/viewoptions.h>
 #include <app/caret.h>
+#include <app/pubsub/scorechangepubsub.h>
 #include <boost/filesystem/path.hpp>
 #include <boost/optional/optional.hpp>
+#include <future>
 #include <memory>
 #include <score/score.h>
+#include <thread>
 #include <vector>
 
+class NavigationIndex;
+class PerformanceOrder;
+class PlaybackTimeline;
+class ScoreChange;
 class SettingsManager;
 
 /// A document is a score that is either associated with a file or unsaved.
@@ -35,6 +42,7 @@ public:
     using PathType = boost::filesystem::path;
 
     Document();
+    ~Document();
     Document(const Document &) = delete;
     Document &operator=(const Document &) = delete;
 
@@ -54,11 +62,69 @@ public:
     const Caret &getCaret() const;
     Caret &getCaret();
 
+    /// Returns the order in which the score's bars are played. This is only
+    /// computed once until a change to the systems is reported through
+    /// notifyChanged().
+    std::shared_ptr<const PerformanceOrder> getPerformanceOrder() const;
+    /// Returns the performance order if it is available without loading any
+    /// systems on this thread, or null. Until every system has been loaded,
+    /// the order is only available once the background computation of the
+    /// playback timeline (which also computes the order) has finished.
+    std::shared_ptr<const PerformanceOrder> findPerformanceOrder() const;
+    /// Returns a map between playback times and locations in the score, which
+    /// is also cached until the systems are modified. Computing this requires
+    /// generating the MIDI events for the whole score.
+    std::shared_ptr<const PlaybackTimeline> getPlaybackTimeline() const;
+    /// Returns the playback timeline if it is available without blocking
+    /// (including from a finished background computation), or null.
+    std::shared_ptr<const PlaybackTimeline> findPlaybackTimeline() const;
+    /// Starts computing the playback timeline on a background thread, using
+    /// a copy of the score, if it isn't already available or being computed.
+    /// The result is only used if the score hasn't changed in the meantime.
+    /// Returns whether a result is pending, i.e. whether
+    /// findPlaybackTimeline() should be checked again later.
+    bool updatePlaybackTimelineAsync();
+    /// Returns an index of the bars and rehearsal signs in the score, which is
+    /// also cached until the systems are modified.
+    std::shared_ptr<const NavigationIndex> getNavigationIndex() const;
+
+    /// Returns a number that is incremented every time the score is modified.
+    uint64_t getRevision() const { return myRevision; }
+    /// Records that part of the score was modified. This must be called
+    /// whenever the score is modified, so that any data computed from the
+    /// modified parts is discarded and subscribers are notified.
+    void notifyChanged(const ScoreChange &change);
+    /// Notifications that are sent from notifyChanged().
+    ScoreChangePubSub &getChangePubSub() { return myChangePubSub; }
+
 private:
+    /// Waits for the background computation of the timeline, and keeps the
+    /// timeline and performance order if they are for the current revision of
+    /// the score. If the computation failed, the result is dropped.
+    void collectPlaybackTimeline() const;
+
     boost::optional<PathType> myFilename;
     Score myScore;
     ViewOptions myViewOptions;
     Caret myCaret;
+    mutable std::shared_ptr<const PerformanceOrder> myPerformanceOrder;
+    mutable std::shared_ptr<const PlaybackTimeline> myPlaybackTimeline;
+    mutable std::shared_ptr<const NavigationIndex> myNavigationIndex;
+    mutable std::thread myTimelineThread;
+    /// The results of the background computation.
+    struct TimelineResult
+    {
+        std::shared_ptr<const PerformanceOrder> myOrder;
+        std::shared_ptr<const PlaybackTimeline> myTimeline;
+    };
+    mutable std::future<TimelineResult> myTimelineResult;
+    /// The revision of the score that the background timeline is for.
+    uint64_t myTimelineRevision;
+    /// The last revision of the score for which the background timeline
+    /// could not be computed.
+    mutable boost::optional<uint64_t> myFailedTimelineRevision;
+    uint64_t myRevision;
+    ScoreChangePubSub myChangePubSub;
 };
 
 /// Class for managing open documents.
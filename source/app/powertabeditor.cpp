@@ -69,6 +69,7 @@
 #include <actions/removesystem.h>
 #include <actions/removetempomarker.h>
 #include <actions/removetextitem.h>
+#include <actions/scorechange.h>
 #include <actions/shiftpositions.h>
 #include <actions/undomanager.h>
 
@@ -80,6 +81,7 @@
 #include <app/paths.h>
 #include <app/pubsub/clickpubsub.h>
 #include <app/recentfiles.h>
+#include <app/redrawscheduler.h>
 #include <app/scorearea.h>
 #include <app/settings.h>
 #include <app/settingsmanager.h>
@@ -91,6 +93,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/range/algorithm/transform.hpp>
 #include <chrono>
+#include <cstdlib>
 
 #include <dialogs/alterationofpacedialog.h>
 #include <dialogs/alternateendingdialog.h>
@@ -107,6 +110,7 @@
 #include <dialogs/keyboardsettingsdialog.h>
 #include <dialogs/keysignaturedialog.h>
 #include <dialogs/lefthandfingeringdialog.h>
+#include <dialogs/memoryusagedialog.h>
 #include <dialogs/multibarrestdialog.h>
 #include <dialogs/playerchangedialog.h>
 #include <dialogs/preferencesdialog.h>
@@ -122,6 +126,9 @@
 
 #include <formats/fileformatmanager.h>
 
+#include <midi/performanceorder.h>
+#include <midi/playbacktimeline.h>
+
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDesktopServices>
@@ -129,6 +136,7 @@
 #include <QFileDialog>
 #include <QFontDatabase>
 #include <QKeyEvent>
+#include <QLabel>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QMimeData>
@@ -136,11 +144,14 @@
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
 #include <QScrollArea>
+#include <QStatusBar>
 #include <QTabBar>
+#include <QTimer>
 #include <QUrl>
 #include <QVBoxLayout>
 
 #include <score/utils.h>
+#include <score/utils/parallelsystems.h>
 #include <score/voiceutils.h>
 
 #include <widgets/instruments/instrumentpanel.h>
@@ -155,6 +166,9 @@ PowerTabEditor::PowerTabEditor()
       myUndoManager(new UndoManager()),
       myTuningDictionary(new TuningDictionary()),
       myIsPlaying(false),
+      myPerformanceBarHint(-1),
+      myPlaybackStartBar(-1),
+      myTimelineTimer(nullptr),
       myRecentFiles(nullptr),
       myActiveDurationType(Position::EighthNote),
       myTabWidget(nullptr),
@@ -163,12 +177,18 @@ PowerTabEditor::PowerTabEditor()
       myInstrumentPanel(nullptr),
       myInstrumentDockWidget(nullptr),
       myPlaybackWidget(nullptr),
-      myPlaybackArea(nullptr)
+      myPlaybackArea(nullptr),
+      myUndoMemoryLabel(nullptr)
 {
     this->setWindowIcon(QIcon(":icons/app_icon.png"));
 
     setAcceptDrops(true);
 
+    // Files are imported on the GUI thread, so the importers can use the
+    // other cores (e.g. to reformat the systems).
+    myFileFormatManager->setNumImportThreads(
+        ScoreUtils::ParallelOptions::allThreads().myNumThreads);
+
     // Load the music notation font.
     QFontDatabase::addApplicationFont(":fonts/emmentaler-13.otf");
     // Load the tab note font.
@@ -179,8 +199,52 @@ PowerTabEditor::PowerTabEditor()
             SLOT(redrawSystem(int)));
     connect(myUndoManager.get(), SIGNAL(fullRedrawNeeded()), this,
             SLOT(redrawScore()));
-    connect(myUndoManager.get(), SIGNAL(cleanChanged(bool)), this,
+    connect(myUndoManager.get(), SIGNAL(modifiedChanged(bool)), this,
             SLOT(updateModified(bool)));
+    connect(myUndoManager.get(), SIGNAL(memoryUsageChanged()), this,
+            SLOT(updateUndoMemoryLabel()));
+    connect(myUndoManager.get(), &UndoManager::scoreChanged, this,
+            [=](const ScoreChange &change) {
+        // Discard anything that was computed from the modified parts of the
+        // score (e.g. the order in which the bars are played).
+        if (myDocumentManager->hasOpenDocuments())
+            myDocumentManager->getCurrentDocument().notifyChanged(change);
+    });
+    connect(myUndoManager.get(), &UndoManager::indexChanged, this, [=]() {
+        if (myDocumentManager->hasOpenDocuments())
+            updateLocationLabel();
+    });
+    connect(myUndoManager.get(), SIGNAL(activeStackChanged(QUndoStack *)),
+            this, SLOT(updateUndoMemoryLabel()));
+    connect(myUndoManager.get(), &UndoManager::historyDiscarded, this, [=]() {
+        statusBar()->showMessage(
+            tr("The undo history was discarded because it exceeded the "
+               "memory limit."),
+            5000);
+    });
+
+    myUndoMemoryLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(myUndoMemoryLabel);
+
+    // Generating the playback timeline requires generating the MIDI events
+    // for the whole score, so wait until editing pauses and then compute it in
+    // the background.
+    myTimelineTimer = new QTimer(this);
+    myTimelineTimer->setSingleShot(true);
+    myTimelineTimer->setInterval(250);
+    connect(myTimelineTimer, &QTimer::timeout, this, [=]() {
+        if (!myDocumentManager->hasOpenDocuments())
+            return;
+
+        Document &doc = myDocumentManager->getCurrentDocument();
+        if (doc.findPlaybackTimeline())
+            updateLocationLabel();
+        else if (doc.updatePlaybackTimelineAsync())
+        {
+            // Check again later for the result.
+            myTimelineTimer->start();
+        }
+    });
 
     myTuningDictionary->loadInBackground();
     mySettingsManager->load(Paths::getConfigDir());
@@ -300,6 +364,7 @@ void PowerTabEditor::switchTab(int index)
         myMixer->reset(doc.getScore());
         myInstrumentPanel->reset(doc.getScore());
         myPlaybackWidget->reset(doc);
+        myPerformanceBarHint = -1;
         updateLocationLabel();
     }
     else
@@ -457,9 +522,22 @@ bool PowerTabEditor::saveFileAs()
         return false;
 }
 
-void PowerTabEditor::updateModified(bool clean)
+void PowerTabEditor::updateModified(bool modified)
 {
-    setWindowModified(!clean);
+    setWindowModified(modified);
+}
+
+void PowerTabEditor::updateUndoMemoryLabel()
+{
+    if (!myUndoManager->activeStack())
+    {
+        myUndoMemoryLabel->clear();
+        return;
+    }
+
+    const size_t bytes = myUndoManager->getMemoryUsage();
+    myUndoMemoryLabel->setText(tr("Undo History: %1 MB")
+                                   .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1));
 }
 
 void PowerTabEditor::cycleTab(int offset)
@@ -564,11 +642,12 @@ void PowerTabEditor::editFileInformation()
     {
         myUndoManager->push(
             new EditFileInformation(getLocation(), dialog.getScoreInfo()),
-            UndoManager::AFFECTS_ALL_SYSTEMS);
+            ScoreChange::properties(ScoreChange::ScoreInfo));
     }
 }
 
-void PowerTabEditor::startStopPlayback(bool from_measure_start)
+void PowerTabEditor::startStopPlayback(bool from_measure_start,
+                                       int start_time)
 {
     myIsPlaying = !myIsPlaying;
 
@@ -586,17 +665,40 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
 
         getCaret().setIsInPlaybackMode(true);
         myPlaybackWidget->setPlaybackMode(true);
-        enableEditing(false);
+        myPlaybackStartBar = myPerformanceBarHint;
+
+        // The MIDI player uses its own copy of the score, so the score can
+        // still be edited. However, the document can't be closed or switched.
+        myCloseTabCommand->setEnabled(false);
+        myNextTabCommand->setEnabled(false);
+        myPrevTabCommand->setEnabled(false);
+        myPlayFromStartOfMeasureCommand->setEnabled(false);
+        myStopCommand->setEnabled(true);
+        myTabWidget->tabBar()->setEnabled(false);
 
         const ScoreLocation &location = getLocation();
         myMidiPlayer.reset(
             new MidiPlayer(*mySettingsManager, location,
+                           myDocumentManager->getCurrentDocument()
+                               .getPerformanceOrder(),
                            myPlaybackWidget->getPlaybackSpeed()));
+        if (start_time >= 0)
+            myMidiPlayer->setStartTime(start_time);
+
+        const int total_time = static_cast<int>(
+            myDocumentManager->getCurrentDocument()
+                .getPlaybackTimeline()
+                ->getDuration() /
+            1000);
 
         connect(myMidiPlayer.get(), SIGNAL(playbackSystemChanged(int)), this,
                 SLOT(moveCaretToSystem(int)));
         connect(myMidiPlayer.get(), SIGNAL(playbackPositionChanged(int)), this,
                 SLOT(moveCaretToPosition(int)));
+        connect(myMidiPlayer.get(), &MidiPlayer::playbackTimeChanged,
+                myPlaybackWidget, [=](int elapsed) {
+                    myPlaybackWidget->setPlaybackTime(elapsed, total_time);
+                });
         connect(myMidiPlayer.get(), SIGNAL(finished()), this,
                 SLOT(startStopPlayback()));
         connect(myPlaybackWidget, &PlaybackWidget::playbackSpeedChanged,
@@ -630,7 +732,7 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
 void PowerTabEditor::redrawSystem(int index)
 {
     getCaret().moveToValidPosition();
-    getScoreArea()->redrawSystem(index);
+    getScoreArea()->getRedrawScheduler().requestSystemRedraw(index);
     updateCommands();
 }
 
@@ -639,7 +741,7 @@ void PowerTabEditor::redrawScore()
     Document &doc = myDocumentManager->getCurrentDocument();
     doc.validateViewOptions();
     getCaret().moveToValidPosition();
-    getScoreArea()->renderDocument(doc);
+    getScoreArea()->getRedrawScheduler().requestFullRedraw();
     updateCommands();
 
     myMixer->reset(doc.getScore());
@@ -806,7 +908,8 @@ void PowerTabEditor::removeSelectedPositions()
 
 void PowerTabEditor::gotoBarline()
 {
-    GoToBarlineDialog dialog(this, getLocation().getScore());
+    auto index = myDocumentManager->getCurrentDocument().getNavigationIndex();
+    GoToBarlineDialog dialog(this, getLocation().getScore(), *index);
 
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -818,7 +921,8 @@ void PowerTabEditor::gotoBarline()
 
 void PowerTabEditor::gotoRehearsalSign()
 {
-    GoToRehearsalSignDialog dialog(this, getLocation().getScore());
+    auto index = myDocumentManager->getCurrentDocument().getNavigationIndex();
+    GoToRehearsalSignDialog dialog(this, getLocation().getScore(), *index);
 
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -1554,7 +1658,7 @@ void PowerTabEditor::addPlayer()
     player.setTuning(settings->get(Settings::DefaultTuning));
 
     myUndoManager->push(new AddPlayer(score, player),
-                        UndoManager::AFFECTS_ALL_SYSTEMS);
+                        ScoreChange::allPlayers());
 }
 
 void PowerTabEditor::addInstrument()
@@ -1595,7 +1699,7 @@ void PowerTabEditor::addInstrument()
     instrument.setMidiPreset(settings->get(Settings::DefaultInstrumentPreset));
 
     myUndoManager->push(new AddInstrument(location.getScore(), instrument),
-                        UndoManager::AFFECTS_ALL_SYSTEMS);
+                        ScoreChange::allInstruments());
 }
 
 void PowerTabEditor::editPlayerChange()
@@ -1639,12 +1743,16 @@ void PowerTabEditor::editPlayer(int playerIndex, const Player &player,
     ScoreLocation &location = getLocation();
 
     if (!undoable)
+    {
         location.getScore().getPlayers()[playerIndex] = player;
+        myDocumentManager->getCurrentDocument().notifyChanged(
+            ScoreChange::player(playerIndex));
+    }
     else
     {
         myUndoManager->push(
             new EditPlayer(location.getScore(), playerIndex, player),
-            UndoManager::AFFECTS_ALL_SYSTEMS);
+            ScoreChange::player(playerIndex));
     }
 }
 
@@ -1652,8 +1760,9 @@ void PowerTabEditor::removePlayer(int index)
 {
     ScoreLocation &location = getLocation();
 
+    // Removing a player also updates the player changes in each system.
     myUndoManager->push(new RemovePlayer(location.getScore(), index),
-                        UndoManager::AFFECTS_ALL_SYSTEMS);
+                        ScoreChange::allPlayers() | ScoreChange::allSystems());
 }
 
 void PowerTabEditor::editInstrument(int index, const Instrument &instrument)
@@ -1662,13 +1771,15 @@ void PowerTabEditor::editInstrument(int index, const Instrument &instrument)
 
     myUndoManager->push(
         new EditInstrument(location.getScore(), index, instrument),
-        UndoManager::AFFECTS_ALL_SYSTEMS);
+        ScoreChange::instrument(index));
 }
 
 void PowerTabEditor::removeInstrument(int index)
 {
+    // Removing an instrument also updates the player changes in each system.
     myUndoManager->push(new RemoveInstrument(getLocation().getScore(), index),
-                        UndoManager::AFFECTS_ALL_SYSTEMS);
+                        ScoreChange::allInstruments() |
+                            ScoreChange::allSystems());
 }
 
 void PowerTabEditor::showTuningDictionary()
@@ -1685,16 +1796,12 @@ void PowerTabEditor::editViewFilters()
     {
         myUndoManager->push(new EditViewFilters(getLocation().getScore(),
                                                 presenter.getFilters()),
-                            UndoManager::AFFECTS_ALL_SYSTEMS);
+                            ScoreChange::properties(ScoreChange::ViewFilters));
     }
 }
 
 bool PowerTabEditor::eventFilter(QObject *object, QEvent *event)
 {
-    // Don't handle key presses during playback.
-    if (myIsPlaying)
-        return QMainWindow::eventFilter(object, event);
-
     ScoreArea *scorearea = getScoreArea();
     if (scorearea && event->type() == QEvent::KeyPress)
     {
@@ -2533,6 +2640,14 @@ void PowerTabEditor::createCommands()
         QDesktopServices::openUrl(QUrl(AppInfo::BUG_TRACKER_URL));
     });
 
+    myMemoryUsageCommand = new Command(tr("Memory Usage..."),
+                                       "Help.MemoryUsage", QKeySequence(),
+                                       this);
+    connect(myMemoryUsageCommand, &QAction::triggered, [=]() {
+        MemoryUsageDialog dialog(this, *myDocumentManager);
+        dialog.exec();
+    });
+
     myMixerDockWidgetCommand =
         createCommandWrapper(myMixerDockWidget->toggleViewAction(),
                              "Window.Mixer", QKeySequence(), this);
@@ -2911,6 +3026,7 @@ void PowerTabEditor::createMenus()
     // Help menu.
     myHelpMenu = menuBar()->addMenu(tr("&Help"));
     myHelpMenu->addAction(myReportBugCommand);
+    myHelpMenu->addAction(myMemoryUsageCommand);
 }
 
 void PowerTabEditor::createTabArea()
@@ -2937,6 +3053,9 @@ void PowerTabEditor::createTabArea()
     connect(myPlaybackWidget, &PlaybackWidget::zoomChanged, this,
             &PowerTabEditor::updateZoom);
 
+    connect(myPlaybackWidget, &PlaybackWidget::seekRequested, this,
+            &PowerTabEditor::seekPlayback);
+
     auto update_metronome_state = [&]() {
         auto settings = mySettingsManager->getReadHandle();
         myMetronomeCommand->setChecked(
@@ -2946,6 +3065,15 @@ void PowerTabEditor::createTabArea()
     update_metronome_state();
     mySettingsManager->subscribeToChanges(update_metronome_state);
 
+    auto update_undo_limit = [&]() {
+        auto settings = mySettingsManager->getReadHandle();
+        const int limit = settings->get(Settings::UndoMemoryLimit);
+        myUndoManager->setMemoryLimit(static_cast<size_t>(limit) * 1024 * 1024);
+    };
+
+    update_undo_limit();
+    mySettingsManager->subscribeToChanges(update_undo_limit);
+
     myPlaybackArea = new QWidget(this);
     QVBoxLayout *layout = new QVBoxLayout(myPlaybackArea);
     layout->addWidget(myTabWidget);
@@ -2980,6 +3108,23 @@ void PowerTabEditor::setupNewTab()
         updateLocationLabel();
     });
 
+    doc.getChangePubSub().subscribe([=](uint64_t, const ScoreChange &change) {
+        if (myIsPlaying && myMidiPlayer)
+        {
+            auto settings = mySettingsManager->getReadHandle();
+            if (settings->get(Settings::MidiFollowEdits))
+            {
+                Document &current = myDocumentManager->getCurrentDocument();
+                myMidiPlayer->updateScore(current.getScore(),
+                                          current.getPerformanceOrder());
+            }
+        }
+
+        // Rebuild the playback timeline once editing pauses.
+        if (change.affectsAnySystem())
+            myTimelineTimer->start();
+    });
+
     auto scorearea = new ScoreArea(this);
     scorearea->renderDocument(doc);
     scorearea->installEventFilter(this);
@@ -3079,10 +3224,7 @@ inline void updateNoteProperty(Command *command, const Note *note,
 
 void PowerTabEditor::updateCommands()
 {
-    if (myIsPlaying)
-        return;
-
-    ScoreLocation location = getLocation();
+    const ScoreLocation &location = getLocation();
     const Score &score = location.getScore();
     if (score.getSystems().empty())
         return;
@@ -3370,9 +3512,32 @@ void PowerTabEditor::stopPlayback()
     const ScoreLocation start_location = myMidiPlayer->getStartLocation();
 
     startStopPlayback();
+    myPerformanceBarHint = myPlaybackStartBar;
     getCaret().moveToLocation(start_location);
 }
 
+void PowerTabEditor::seekPlayback(int milliseconds)
+{
+    if (!myDocumentManager->hasOpenDocuments())
+        return;
+
+    const bool wasPlaying = myIsPlaying;
+
+    if (wasPlaying)
+        startStopPlayback();
+
+    auto timeline =
+        myDocumentManager->getCurrentDocument().getPlaybackTimeline();
+    const int64_t time = static_cast<int64_t>(milliseconds) * 1000;
+    const SystemLocation location = timeline->findLocation(time);
+    myPerformanceBarHint = timeline->findBarIndex(time);
+    moveCaretToSystem(location.getSystem());
+    moveCaretToPosition(location.getPosition());
+
+    if (wasPlaying)
+        startStopPlayback(false, milliseconds);
+}
+
 void PowerTabEditor::toggleMetronome()
 {
     auto settings = mySettingsManager->getWriteHandle();
@@ -3399,8 +3564,64 @@ void PowerTabEditor::updateZoom(double percent)
 
 void PowerTabEditor::updateLocationLabel()
 {
-    myPlaybackWidget->updateLocationLabel(
-        boost::lexical_cast<std::string>(getCaret().getLocation()));
+    const ScoreLocation &location = getCaret().getLocation();
+    QString text =
+        QString::fromStdString(boost::lexical_cast<std::string>(location));
+
+    // Display which bar this is in the performance of the score. If the bar
+    // is repeated, choose the pass closest to where the caret previously was
+    // (e.g. after seeking or during playback). Computing the order would load
+    // every system of a file that is loaded on demand, so until the systems
+    // have been loaded it is taken from the background computation of the
+    // playback timeline.
+    Document &doc = myDocumentManager->getCurrentDocument();
+    auto order = doc.findPerformanceOrder();
+    const SystemLocation systemLocation(location.getSystemIndex(),
+                                        location.getPositionIndex());
+    std::vector<int> candidates;
+    if (order)
+        candidates = order->findBarIndices(systemLocation);
+    else
+        myTimelineTimer->start();
+
+    int bar = -1;
+    for (int candidate : candidates)
+    {
+        if (bar < 0 || std::abs(candidate - myPerformanceBarHint) <
+                           std::abs(bar - myPerformanceBarHint))
+        {
+            bar = candidate;
+        }
+    }
+
+    if (bar >= 0)
+    {
+        myPerformanceBarHint = bar;
+
+        text += tr(", Bar %1 of %2")
+                    .arg(bar + 1)
+                    .arg(static_cast<int>(order->getBars().size()));
+    }
+
+    myPlaybackWidget->updateLocationLabel(text.toStdString());
+
+    // During playback, the MIDI player reports the elapsed time instead, since
+    // it knows which pass through a repeat is being played.
+    if (!myIsPlaying && bar >= 0)
+    {
+        auto timeline = doc.findPlaybackTimeline();
+        if (!timeline)
+        {
+            myTimelineTimer->start();
+            return;
+        }
+
+        const int64_t time = timeline->findTime(bar, systemLocation);
+
+        myPlaybackWidget->setPlaybackTime(
+            static_cast<int>(time / 1000),
+            static_cast<int>(timeline->getDuration() / 1000));
+    }
 }
 
 void PowerTabEditor::editKeySignature(const ScoreLocation &keyLocation)
@@ -3564,7 +3785,8 @@ void PowerTabEditor::insertStaff(int index)
 {
     StaffDialog dialog(this);
 
-    const Staff &current_staff = getLocation().getStaff();
+    const ScoreLocation &location = getLocation();
+    const Staff &current_staff = location.getStaff();
     dialog.setStringCount(current_staff.getStringCount());
 
     if (dialog.exec() == QDialog::Accepted)
@@ -3601,7 +3823,7 @@ void PowerTabEditor::editStaff(int system, int staff)
 void PowerTabEditor::adjustLineSpacing(int amount)
 {
     myUndoManager->push(new AdjustLineSpacing(getLocation().getScore(), amount),
-                        UndoManager::AFFECTS_ALL_SYSTEMS);
+                        ScoreChange::properties(ScoreChange::LineSpacing));
 }
 
 ScoreArea *PowerTabEditor::getScoreArea()
@@ -36,6 +36,8 @@ class MidiPlayer;
 class Mixer;
 class PlaybackWidget;
 class QActionGroup;
+class QLabel;
+class QTimer;
 class RecentFiles;
 class ScoreArea;
 class ScoreLocation;
@@ -91,6 +93,12 @@ private slots:
     /// modified.
     void updateModified(bool);
 
+    /// Displays the estimated memory usage of the current document's undo
+    /// history in the status bar. This reads the undo manager's running total,
+    /// so it only needs to be called when that changes or the active document
+    /// changes.
+    void updateUndoMemoryLabel();
+
     /// Cycles through the tabs in the tab bar.
     /// @param offset Direction and number of tabs to move by
     /// (i.e. -1 moves back one tab).
@@ -116,12 +124,15 @@ private slots:
     /// Opens the file information dialog.
     void editFileInformation();
 
-    /// Starts or stops playback of the score.
-    void startStopPlayback(bool from_measure_start = false);
+    /// Starts or stops playback of the score. If a start time (in
+    /// milliseconds) is provided, playback begins at that point in the
+    /// performance rather than at the caret.
+    void startStopPlayback(bool from_measure_start = false,
+                           int start_time = -1);
 
-    /// Redraws only the given system.
+    /// Schedules a redraw of the given system.
     void redrawSystem(int);
-    /// Redraws the entire score.
+    /// Schedules a redraw of the entire score.
     void redrawScore();
 
     /// Moves the caret to the first position in the staff.
@@ -339,6 +350,9 @@ private:
     void rewindPlaybackToStart();
     /// Stops playback and returns to the initial position.
     void stopPlayback();
+    /// Moves the caret to the given playback time, and restarts playback from
+    /// there if necessary.
+    void seekPlayback(int milliseconds);
     /// Toggles the metronome on or off.
     void toggleMetronome();
     /// Sets the current voice that is being edited.
@@ -400,6 +414,13 @@ private:
     InstrumentRemovePubSub myInstrumentRemovePubSub;
     /// Tracks whether we are currently in playback mode.
     bool myIsPlaying;
+    /// The bar of the performance that the caret was last in, which is used
+    /// to choose between the passes through a repeated bar.
+    int myPerformanceBarHint;
+    /// The performance bar that playback was started from.
+    int myPlaybackStartBar;
+    /// Delays computing the playback timeline until editing pauses.
+    QTimer *myTimelineTimer;
     /// Tracks the last directory that a file was opened from.
     QString myPreviousDirectory;
     RecentFiles *myRecentFiles;
@@ -412,6 +433,7 @@ private:
     QDockWidget *myInstrumentDockWidget;
     PlaybackWidget *myPlaybackWidget;
     QWidget *myPlaybackArea;
+    QLabel *myUndoMemoryLabel;
 
     QMenu *myFileMenu;
     Command *myNewDocumentCommand;
@@ -590,6 +612,7 @@ private:
 
     QMenu *myHelpMenu;
     Command *myReportBugCommand;
+    Command *myMemoryUsageCommand;
 
 #if 0
 
@@ -0,0 +1,33 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef APP_SCORECHANGEPUBSUB_H
+#define APP_SCORECHANGEPUBSUB_H
+
+#include <app/pubsub/pubsub.h>
+#include <cstdint>
+
+class ScoreChange;
+
+/// Notifications about a document's score being modified. The new revision
+/// number is sent along with a description of what was changed.
+class ScoreChangePubSub : public PubSub<void (uint64_t, const ScoreChange &)>
+{
+};
+
+#endif
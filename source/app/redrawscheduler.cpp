@@ -0,0 +1,99 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "redrawscheduler.h"
+
+#include <QTimer>
+
+RedrawScheduler::RedrawScheduler(const SystemCountFunction &systemCount,
+                                 const SystemRedrawFunction &redrawSystem,
+                                 const FullRedrawFunction &redrawScore,
+                                 QObject *parent)
+    : QObject(parent),
+      mySystemCount(systemCount),
+      myRedrawSystem(redrawSystem),
+      myRedrawScore(redrawScore),
+      myFullRedrawNeeded(false),
+      myIsScheduled(false)
+{
+}
+
+void RedrawScheduler::requestSystemRedraw(int index)
+{
+    if (!myFullRedrawNeeded)
+        myDirtySystems.insert(index);
+
+    schedule();
+}
+
+void RedrawScheduler::requestFullRedraw()
+{
+    myFullRedrawNeeded = true;
+    myDirtySystems.clear();
+
+    schedule();
+}
+
+void RedrawScheduler::flush()
+{
+    if (!hasPendingRedraws())
+        return;
+
+    // Redrawing a system also shifts all of the following systems, so once
+    // more than half of the score is dirty it is cheaper to redraw everything.
+    // A full redraw is also needed if systems were removed in the meantime.
+    const int systemCount = mySystemCount();
+    bool fullRedraw = myFullRedrawNeeded ||
+                      static_cast<int>(myDirtySystems.size()) * 2 > systemCount;
+    if (!myDirtySystems.empty() && *myDirtySystems.rbegin() >= systemCount)
+        fullRedraw = true;
+
+    const std::set<int> dirtySystems = std::move(myDirtySystems);
+    myDirtySystems.clear();
+    myFullRedrawNeeded = false;
+
+    if (fullRedraw)
+        myRedrawScore();
+    else
+    {
+        for (int index : dirtySystems)
+            myRedrawSystem(index);
+    }
+}
+
+void RedrawScheduler::cancel()
+{
+    myDirtySystems.clear();
+    myFullRedrawNeeded = false;
+}
+
+bool RedrawScheduler::hasPendingRedraws() const
+{
+    return myFullRedrawNeeded || !myDirtySystems.empty();
+}
+
+void RedrawScheduler::schedule()
+{
+    if (myIsScheduled)
+        return;
+
+    myIsScheduled = true;
+    QTimer::singleShot(0, this, [=]() {
+        myIsScheduled = false;
+        flush();
+    });
+}
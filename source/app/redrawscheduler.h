@@ -0,0 +1,65 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef APP_REDRAWSCHEDULER_H
+#define APP_REDRAWSCHEDULER_H
+
+#include <functional>
+#include <QObject>
+#include <set>
+
+/// Collects requests to redraw systems or the whole score, and performs a
+/// single redraw pass once control returns to the event loop. This avoids
+/// redrawing the same system many times when e.g. undoing a large macro.
+class RedrawScheduler : public QObject
+{
+public:
+    typedef std::function<int()> SystemCountFunction;
+    typedef std::function<void(int)> SystemRedrawFunction;
+    typedef std::function<void()> FullRedrawFunction;
+
+    RedrawScheduler(const SystemCountFunction &systemCount,
+                    const SystemRedrawFunction &redrawSystem,
+                    const FullRedrawFunction &redrawScore,
+                    QObject *parent = nullptr);
+
+    /// Marks a system as needing to be redrawn.
+    void requestSystemRedraw(int index);
+    /// Marks the entire score as needing to be redrawn.
+    void requestFullRedraw();
+
+    /// Performs any pending redraws immediately.
+    void flush();
+    /// Discards any pending redraws (e.g. if the document was closed).
+    void cancel();
+
+    /// Returns whether there are any pending redraws.
+    bool hasPendingRedraws() const;
+
+private:
+    void schedule();
+
+    SystemCountFunction mySystemCount;
+    SystemRedrawFunction myRedrawSystem;
+    FullRedrawFunction myRedrawScore;
+
+    std::set<int> myDirtySystems;
+    bool myFullRedrawNeeded;
+    bool myIsScheduled;
+};
+
+#endif
@@ -19,13 +19,16 @@
 
 #include <app/documentmanager.h>
 #include <app/pubsub/clickpubsub.h>
+#include <app/redrawscheduler.h>
 #include <chrono>
 #include <future>
 #include <painters/caretpainter.h>
+#include <painters/layoutinfo.h>
 #include <painters/scoreinforenderer.h>
 #include <painters/systemrenderer.h>
 #include <QDebug>
 #include <QGraphicsItem>
+#include <QGraphicsRectItem>
 #include <QGraphicsSceneDragDropEvent>
 #include <QPrinter>
 #include <QScrollBar>
@@ -33,6 +36,31 @@
 
 static const double SYSTEM_SPACING = 50;
 
+/// Height of a placeholder when there isn't a previous system to copy,
+/// which is roughly the height of a system with a single staff.
+static const double DEFAULT_PLACEHOLDER_HEIGHT = 250;
+
+namespace
+{
+/// Reserves space for a system that hasn't been rendered yet.
+class SystemPlaceholder : public QGraphicsRectItem
+{
+public:
+    enum { Type = UserType + 1 };
+
+    explicit SystemPlaceholder(double height)
+        : QGraphicsRectItem(0, 0, LayoutInfo::STAFF_WIDTH, height)
+    {
+        setPen(Qt::NoPen);
+    }
+
+    virtual int type() const override
+    {
+        return Type;
+    }
+};
+}
+
 void ScoreArea::Scene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
 {
     event->ignore();
@@ -42,13 +70,33 @@ ScoreArea::ScoreArea(QWidget *parent)
     : QGraphicsView(parent),
       myScoreInfoBlock(nullptr),
       myCaretPainter(nullptr),
+      myIsRenderingPlaceholders(false),
       myClickPubSub(std::make_shared<ClickPubSub>())
 {
     setScene(&myScene);
+
+    myRedrawScheduler.reset(new RedrawScheduler(
+        [=]() {
+            return myDocument ? static_cast<int>(
+                                    myDocument->getScore().getSystems().size())
+                              : 0;
+        },
+        [=](int index) { redrawSystem(index); },
+        [=]() {
+            if (myDocument)
+                renderDocument(*myDocument);
+        }));
+}
+
+ScoreArea::~ScoreArea()
+{
 }
 
 void ScoreArea::renderDocument(const Document &document)
 {
+    // Any pending redraws are now unnecessary.
+    myRedrawScheduler->cancel();
+
     myScene.clear();
     myRenderedSystems.clear();
     myDocument = document;
@@ -60,7 +108,16 @@ void ScoreArea::renderDocument(const Document &document)
     myCaretPainter =
         new CaretPainter(document.getCaret(), document.getViewOptions());
     myCaretPainter->subscribeToMovement([=]() {
-        adjustScroll();
+        if (myIsRenderingPlaceholders)
+            return;
+
+        // If the caret moved to a system that hasn't been rendered yet, render
+        // it first. This moves the caret again, which adjusts the scroll.
+        const int index = myDocument->getCaret().getLocation().getSystemIndex();
+        if (isPlaceholder(index))
+            redrawSystem(index);
+        else
+            adjustScroll();
     });
 
     myScoreInfoBlock = ScoreInfoRenderer::render(score.getScoreInfo());
@@ -86,10 +143,13 @@ void ScoreArea::renderDocument(const Document &document)
 
         tasks.push_back(std::async(std::launch::async, [&](int left, int right)
         {
+            // Share a renderer between systems so that its fonts and scratch
+            // buffers are reused.
+            SystemRenderer render(this, score, document.getViewOptions());
             for (int i = left; i < right; ++i)
             {
-                SystemRenderer render(this, score, document.getViewOptions());
-                myRenderedSystems[i] = render(score.getSystems()[i], i);
+                if (score.isSystemLoaded(i))
+                    myRenderedSystems[i] = render(score.getSystems()[i], i);
             }
         }, left, right));
     }
@@ -102,9 +162,18 @@ void ScoreArea::renderDocument(const Document &document)
     myScene.addItem(myScoreInfoBlock);
     height += myScoreInfoBlock->boundingRect().height() + 0.5 * SYSTEM_SPACING;
 
-    // Layout the systems.
-    for (QGraphicsItem *system : myRenderedSystems)
+    // Layout the systems. Systems that haven't been loaded from the file yet
+    // are only loaded and rendered once they are scrolled into view, so that
+    // opening a large file is fast. Until then, their placeholder is given
+    // the height of the previous system.
+    double placeholderHeight = DEFAULT_PLACEHOLDER_HEIGHT;
+    for (QGraphicsItem *&system : myRenderedSystems)
     {
+        if (system)
+            placeholderHeight = system->boundingRect().height();
+        else
+            system = new SystemPlaceholder(placeholderHeight);
+
         system->setPos(0, height);
         myScene.addItem(system);
         height += system->boundingRect().height() + SYSTEM_SPACING;
@@ -113,6 +182,7 @@ void ScoreArea::renderDocument(const Document &document)
     }
 
     myScene.addItem(myCaretPainter);
+    renderPlaceholders(true);
 
     auto end = std::chrono::high_resolution_clock::now();
     qDebug() << "Score rendered in"
@@ -122,6 +192,15 @@ void ScoreArea::renderDocument(const Document &document)
 }
 
 void ScoreArea::redrawSystem(int index)
+{
+    renderSystem(index);
+
+    // The spacing may have changed, so update the caret's position and redraw
+    // it.
+    myCaretPainter->updatePosition();
+}
+
+void ScoreArea::renderSystem(int index)
 {
     // Delete and remove the system from the scene.
     delete myRenderedSystems.takeAt(index);
@@ -152,14 +231,61 @@ void ScoreArea::redrawSystem(int index)
         height += system->boundingRect().height() + SYSTEM_SPACING;
         myCaretPainter->setSystemRect(i, system->sceneBoundingRect());
     }
+}
 
-    // The spacing may have changed, so update the caret's position and redraw
-    // it.
-    myCaretPainter->updatePosition();
+bool ScoreArea::isPlaceholder(int index) const
+{
+    return index >= 0 && index < myRenderedSystems.size() &&
+           qgraphicsitem_cast<SystemPlaceholder *>(myRenderedSystems[index]);
+}
+
+void ScoreArea::renderPlaceholders(bool onlyVisible)
+{
+    if (!myDocument || myIsRenderingPlaceholders)
+        return;
+
+    myIsRenderingPlaceholders = true;
+    bool rendered = false;
+
+    for (int i = 0; i < myRenderedSystems.size(); ++i)
+    {
+        if (onlyVisible)
+        {
+            // Rendering a system can change its height, which moves the
+            // following systems, so check the visible area each time.
+            const QRectF visible =
+                mapToScene(viewport()->rect()).boundingRect();
+            const QRectF rect = myRenderedSystems[i]->sceneBoundingRect();
+            if (rect.top() > visible.bottom())
+                break;
+            else if (!rect.intersects(visible))
+                continue;
+        }
+
+        if (isPlaceholder(i))
+        {
+            renderSystem(i);
+            rendered = true;
+        }
+    }
+
+    if (rendered)
+        myCaretPainter->updatePosition();
+
+    myIsRenderingPlaceholders = false;
+}
+
+RedrawScheduler &ScoreArea::getRedrawScheduler()
+{
+    return *myRedrawScheduler;
 }
 
 void ScoreArea::print(QPrinter &printer)
 {
+    // Make sure that any recent edits are included.
+    myRedrawScheduler->flush();
+    renderPlaceholders(false);
+
     QPainter painter;
     painter.begin(&printer);
 
@@ -245,4 +371,19 @@ void ScoreArea::refreshZoom()
     QTransform xform;
     xform.scale(scale_factor, scale_factor);
     setTransform(xform);
+
+    // Zooming out can bring more systems into view.
+    renderPlaceholders(true);
+}
+
+void ScoreArea::resizeEvent(QResizeEvent *event)
+{
+    QGraphicsView::resizeEvent(event);
+    renderPlaceholders(true);
+}
+
+void ScoreArea::scrollContentsBy(int dx, int dy)
+{
+    QGraphicsView::scrollContentsBy(dx, dy);
+    renderPlaceholders(true);
 }
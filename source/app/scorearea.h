@@ -28,6 +28,7 @@ class CaretPainter;
 class ClickPubSub;
 class Document;
 class QPrinter;
+class RedrawScheduler;
 
 /// The visual display of the score.
 class ScoreArea : public QGraphicsView
@@ -43,6 +44,7 @@ class ScoreArea : public QGraphicsView
 
 public:
     explicit ScoreArea(QWidget *parent);
+    ~ScoreArea();
 
     void renderDocument(const Document &document);
 
@@ -54,23 +56,44 @@ public:
     /// necessary.
     void redrawSystem(int index);
 
+    /// Returns the scheduler for redrawing systems after they are modified.
+    /// Redraws are deferred until control returns to the event loop, so that
+    /// a system is only redrawn once after e.g. undoing a macro.
+    RedrawScheduler &getRedrawScheduler();
+
     std::shared_ptr<ClickPubSub> getClickPubSub() const;
 
 protected:
     virtual void focusInEvent(QFocusEvent *event) override;
     virtual void focusOutEvent(QFocusEvent *event) override;
+    virtual void resizeEvent(QResizeEvent *event) override;
+    virtual void scrollContentsBy(int dx, int dy) override;
 
 private:
     /// Adjusts the scroll location whenever the caret moves.
     void adjustScroll();
 
+    /// Renders the specified system, replacing its current item, and shifts
+    /// the following systems as necessary.
+    void renderSystem(int index);
+    /// Returns whether only a placeholder has been created for the system.
+    bool isPlaceholder(int index) const;
+    /// Replaces placeholders with the rendered systems, loading them from the
+    /// score if necessary. If onlyVisible is set, this is limited to the
+    /// systems that have been scrolled into view.
+    void renderPlaceholders(bool onlyVisible);
+
     Scene myScene;
     boost::optional<const Document &> myDocument;
     QGraphicsItem *myScoreInfoBlock;
     QList<QGraphicsItem *> myRenderedSystems;
     CaretPainter *myCaretPainter;
+    /// Set while rendering placeholders, so that updating the caret's position
+    /// doesn't scroll the view.
+    bool myIsRenderingPlaceholders;
 
     std::shared_ptr<ClickPubSub> myClickPubSub;
+    std::unique_ptr<RedrawScheduler> myRedrawScheduler;
 };
 
 #endif
@@ -33,6 +33,8 @@ const Setting<std::vector<std::string>> RecentFiles("app/recent_files", {});
 const Setting<bool> OpenFilesInNewWindow("app/open_files_in_new_window",
                                          false);
 
+const Setting<int> UndoMemoryLimit("app/undo_memory_limit", 256);
+
 const Setting<std::string> DefaultInstrumentName("app/default_instrument_name",
                                                  "Untitled");
 
@@ -30,6 +30,8 @@ namespace Settings
     extern const Setting<QByteArray> WindowState;
     extern const Setting<std::vector<std::string>> RecentFiles;
     extern const Setting<bool> OpenFilesInNewWindow;
+    /// The maximum size of each document's undo history, in megabytes.
+    extern const Setting<int> UndoMemoryLimit;
 
     extern const Setting<std::string> DefaultInstrumentName;
     extern const Setting<int> DefaultInstrumentPreset;
@@ -17,12 +17,13 @@
   
 #include "midiplayer.h"
 
+#include <algorithm>
 #include <app/settingsmanager.h>
 #include <audio/midioutputdevice.h>
 #include <audio/settings.h>
-#include <boost/rational.hpp>
 #include <cassert>
 #include <midi/midifile.h>
+#include <midi/performanceorder.h>
 #include <score/generalmidi.h>
 #include <score/score.h>
 
@@ -32,14 +33,18 @@
 #endif
 
 static const int METRONOME_CHANNEL = 9;
+static const uint8_t ALL_NOTES_OFF = 123;
 
-MidiPlayer::MidiPlayer(SettingsManager &settings_manager,
-                       const ScoreLocation &start_location, int speed)
+MidiPlayer::MidiPlayer(
+    SettingsManager &settings_manager, const ScoreLocation &start_location,
+    std::shared_ptr<const PerformanceOrder> performance_order, int speed)
     : mySettingsManager(settings_manager),
       myScore(start_location.getScore()),
       myStartLocation(start_location),
+      myPerformanceOrder(performance_order),
       myIsPlaying(false),
-      myPlaybackSpeed(speed)
+      myPlaybackSpeed(speed),
+      myHasPendingScore(false)
 {
 }
 
@@ -92,22 +97,11 @@ void MidiPlayer::run()
             settings->get(Settings::MidiWideVibratoLevel);
     }
 
-    MidiFile file;
-    file.load(myScore, options);
-
-    const int ticks_per_beat = file.getTicksPerBeat();
-
-    // Merge the MIDI evvents for each track.
-    MidiEventList events;
-    for (MidiEventList &track : file.getTracks())
-    {
-        track.convertToAbsoluteTicks();
-        events.concat(track);
-    }
-
-    // TODO - since each track is already sorted, an n-way merge should be faster.
-    std::stable_sort(events.begin(), events.end());
-    events.convertToDeltaTicks();
+    int ticks_per_beat;
+    std::vector<int> bar_start_ticks;
+    MidiEventList events = generateEvents(myScore, *myPerformanceOrder,
+                                          options, ticks_per_beat,
+                                          bar_start_ticks);
 
     // Initialize RtMidi and set the port.
     MidiOutputDevice device;
@@ -118,24 +112,50 @@ void MidiPlayer::run()
     }
 
     bool started = false;
-    int beat_duration = Midi::BEAT_DURATION_120_BPM;
+    TempoScale tempo(Midi::BEAT_DURATION_120_BPM, ticks_per_beat);
     const SystemLocation start_location(myStartLocation.getSystemIndex(),
                                         myStartLocation.getPositionIndex());
     SystemLocation current_location = start_location;
+    int64_t elapsed_us = 0;
+    int current_tick = 0;
 
-    for (auto event = events.begin(); event != events.end(); ++event)
+    auto event = events.begin();
+    for (; event != events.end(); ++event)
     {
         if (!isPlaying())
             break;
 
+        // If the score was edited, switch to the new version once all of the
+        // events at the current tick have been played.
+        if (started && myHasPendingScore && event->getTicks() > current_tick)
+        {
+            event = switchToPendingScore(device, options, events,
+                                         bar_start_ticks, current_tick, tempo,
+                                         elapsed_us);
+            if (event == events.end())
+                break;
+        }
+
+        // The time since the previous event uses the tempo that was active
+        // before this event.
+        const int delta = event->getTicks() - current_tick;
+        assert(delta >= 0);
+        current_tick = event->getTicks();
+
+        int duration_us = static_cast<int>(tempo.getTime(delta));
+        elapsed_us += duration_us;
+
         if (event->isTempoChange())
-            beat_duration = event->getTempo();
+            tempo.setBeatDuration(event->getTempo());
 
         // Skip events before the start location, except for events such as
         // instrument changes. Tempo changes are tracked above.
         if (!started)
         {
-            if (event->getLocation() < start_location)
+            const bool before_start =
+                myStartTime ? elapsed_us < *myStartTime
+                            : event->getLocation() < start_location;
+            if (before_start)
             {
                 if (event->isProgramChange())
                     device.sendMessage(event->getData());
@@ -144,18 +164,18 @@ void MidiPlayer::run()
             }
             else
             {
-                performCountIn(device, event->getLocation(), beat_duration);
+                performCountIn(device, event->getLocation(),
+                               tempo.getBeatDuration());
+
+                // Only wait for the remainder of the delta after the start
+                // time.
+                if (myStartTime)
+                    duration_us = static_cast<int>(elapsed_us - *myStartTime);
 
                 started = true;
             }
         }
 
-        const int delta = event->getTicks();
-        assert(delta >= 0);
-
-        const int duration_us = boost::rational_cast<int>(
-            boost::rational<int>(delta, ticks_per_beat) * beat_duration);
-
         usleep(duration_us * (100.0 / myPlaybackSpeed));
 
         // Don't play metronome events if the metronome is disabled.
@@ -180,12 +200,119 @@ void MidiPlayer::run()
                 emit playbackSystemChanged(new_location.getSystem());
 
             emit playbackPositionChanged(new_location.getPosition());
+            emit playbackTimeChanged(static_cast<int>(elapsed_us / 1000));
 
             current_location = new_location;
         }
     }
 }
 
+MidiEventList MidiPlayer::generateEvents(const Score &score,
+                                         const PerformanceOrder &order,
+                                         const MidiFile::LoadOptions &options,
+                                         int &ticks_per_beat,
+                                         std::vector<int> &bar_start_ticks)
+{
+    MidiFile file;
+    file.load(score, order, options);
+
+    ticks_per_beat = file.getTicksPerBeat();
+    bar_start_ticks = file.getBarStartTicks();
+
+    // Merge the MIDI events for each track.
+    MidiEventList events;
+    for (MidiEventList &track : file.getTracks())
+    {
+        track.convertToAbsoluteTicks();
+        events.concat(track);
+    }
+
+    // TODO - since each track is already sorted, an n-way merge should be faster.
+    std::stable_sort(events.begin(), events.end());
+
+    return events;
+}
+
+MidiEventList::iterator MidiPlayer::switchToPendingScore(
+    MidiOutputDevice &device, const MidiFile::LoadOptions &options,
+    MidiEventList &events, std::vector<int> &bar_start_ticks,
+    int &current_tick, TempoScale &tempo, int64_t &elapsed_us)
+{
+    std::unique_ptr<Score> score;
+    std::shared_ptr<const PerformanceOrder> order;
+    {
+        std::lock_guard<std::mutex> lock(myPendingScoreMutex);
+        score = std::move(myPendingScore);
+        order = std::move(myPendingPerformanceOrder);
+        myHasPendingScore = false;
+    }
+
+    // Find the bar of the performance that is currently playing.
+    const int bar = static_cast<int>(
+        std::upper_bound(bar_start_ticks.begin(), bar_start_ticks.end(),
+                         current_tick) -
+        bar_start_ticks.begin() - 1);
+    const int offset = bar >= 0 ? current_tick - bar_start_ticks[bar] : 0;
+
+    int new_ticks_per_beat;
+    std::vector<int> new_bar_start_ticks;
+    MidiEventList new_events = generateEvents(
+        *score, *order, options, new_ticks_per_beat, new_bar_start_ticks);
+    assert(new_ticks_per_beat == tempo.getTicksPerBeat());
+
+    myScore = *score;
+    myPerformanceOrder = order;
+    events = std::move(new_events);
+    bar_start_ticks = std::move(new_bar_start_ticks);
+
+    // Stop any notes from the previous version of the score.
+    for (uint8_t channel = 0; channel < MidiOutputDevice::NUM_CHANNELS;
+         ++channel)
+    {
+        device.sendMessage({ static_cast<uint8_t>(
+                                 MidiEvent::ControlChange + channel),
+                             ALL_NOTES_OFF, 0 });
+    }
+
+    // If the edit removed the current bar, stop playback.
+    if (bar < 0 || bar >= static_cast<int>(bar_start_ticks.size()))
+        return events.end();
+
+    // Continue from the same offset into the current bar. The tempo and
+    // elapsed time may have been changed by edits earlier in the score.
+    const int tick = bar_start_ticks[bar] + offset;
+    int prev_tick = 0;
+    tempo.setBeatDuration(Midi::BEAT_DURATION_120_BPM);
+    elapsed_us = 0;
+
+    auto event = events.begin();
+    for (; event != events.end() && event->getTicks() <= tick; ++event)
+    {
+        elapsed_us += tempo.getTime(event->getTicks() - prev_tick);
+        prev_tick = event->getTicks();
+
+        if (event->isTempoChange())
+            tempo.setBeatDuration(event->getTempo());
+        else if (event->isProgramChange())
+            device.sendMessage(event->getData());
+    }
+
+    elapsed_us += tempo.getTime(tick - prev_tick);
+    current_tick = tick;
+
+    return event;
+}
+
+void MidiPlayer::updateScore(
+    const Score &score,
+    std::shared_ptr<const PerformanceOrder> performance_order)
+{
+    std::lock_guard<std::mutex> lock(myPendingScoreMutex);
+    myPendingScore.reset(new Score(score));
+    myPendingPerformanceOrder = performance_order;
+    myHasPendingScore = true;
+}
+
 void MidiPlayer::performCountIn(MidiOutputDevice &device,
                                 const SystemLocation &location,
                                 int beat_duration)
@@ -204,18 +331,21 @@ void MidiPlayer::performCountIn(MidiOutputDevice &device,
                  Midi::MIDI_PERCUSSION_PRESET_OFFSET;
     }
 
-    // Figure out the time signature where playback is starting.
-    const System &system = myScore.getSystems()[location.getSystem()];
+    // Figure out the time signature where playback is starting. This runs on
+    // the playback thread, so only read from the score to avoid detaching
+    // the systems that it shares with the document.
+    const Score &score = myScore;
+    const System &system = score.getSystems()[location.getSystem()];
     const Barline *barline = system.getPreviousBarline(location.getPosition());
     if (!barline)
         barline = &system.getBarlines().front();
 
     const TimeSignature &time_sig = barline->getTimeSignature();
 
-    const int tick_duration = boost::rational_cast<int>(
-        boost::rational<int>(4, time_sig.getBeatValue()) *
-        boost::rational<int>(time_sig.getBeatsPerMeasure(),
-                             time_sig.getNumPulses()) * beat_duration);
+    const int tick_duration = static_cast<int>(
+        4 * static_cast<int64_t>(time_sig.getBeatsPerMeasure()) *
+        beat_duration /
+        (time_sig.getBeatValue() * time_sig.getNumPulses()));
 
     // Play the count-in.
     device.setChannelMaxVolume(METRONOME_CHANNEL,
@@ -237,6 +367,11 @@ void MidiPlayer::changePlaybackSpeed(int new_speed)
     myPlaybackSpeed = new_speed;
 }
 
+void MidiPlayer::setStartTime(int milliseconds)
+{
+    myStartTime = static_cast<int64_t>(milliseconds) * 1000;
+}
+
 void MidiPlayer::setIsPlaying(bool set)
 {
     myIsPlaying = set;
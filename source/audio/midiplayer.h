@@ -19,26 +19,49 @@
 #define AUDIO_MIDIPLAYER_H
 
 #include <atomic>
+#include <boost/optional/optional.hpp>
+#include <cstdint>
+#include <memory>
+#include <midi/midifile.h>
+#include <midi/temposcale.h>
+#include <mutex>
 #include <QThread>
+#include <score/score.h>
 #include <score/scorelocation.h>
+#include <vector>
 
-class MidiFile;
 class MidiOutputDevice;
-class Score;
+class PerformanceOrder;
 class SettingsManager;
 class SystemLocation;
 
+/// Plays a score on a separate thread. The player uses its own copy of the
+/// score, so the original score can be edited during playback.
 class MidiPlayer : public QThread
 {
     Q_OBJECT
 
 public:
     MidiPlayer(SettingsManager &settings_manager,
-               const ScoreLocation &start_location, int speed);
+               const ScoreLocation &start_location,
+               std::shared_ptr<const PerformanceOrder> performance_order,
+               int speed);
     ~MidiPlayer();
 
     void changePlaybackSpeed(int new_speed);
 
+    /// Starts playback at the given time (in milliseconds from the start of
+    /// the score) rather than at the start location. This allows playback to
+    /// begin partway through a repeated section. This must be called before
+    /// the thread is started.
+    void setStartTime(int milliseconds);
+
+    /// Switches playback to an edited version of the score, starting from the
+    /// same point in the current bar. The MIDI events are regenerated on the
+    /// playback thread before the next note is played.
+    void updateScore(const Score &score,
+                     std::shared_ptr<const PerformanceOrder> performance_order);
+
     const ScoreLocation &getStartLocation() const { return myStartLocation; }
 
 signals:
@@ -46,6 +69,9 @@ signals:
     // necessary
     void playbackSystemChanged(int system);
     void playbackPositionChanged(int position);
+    /// The elapsed time in milliseconds since the start of the score, at
+    /// normal playback speed.
+    void playbackTimeChanged(int milliseconds);
     void error(const QString &msg);
 
 private:
@@ -54,16 +80,41 @@ private:
     void performCountIn(MidiOutputDevice &device,
                         const SystemLocation &location, int beat_duration);
 
+    /// Generates the MIDI events for the score, sorted by their absolute
+    /// ticks.
+    static MidiEventList generateEvents(const Score &score,
+                                        const PerformanceOrder &order,
+                                        const MidiFile::LoadOptions &options,
+                                        int &ticks_per_beat,
+                                        std::vector<int> &bar_start_ticks);
+
+    /// Replaces the MIDI events with the events for the pending version of
+    /// the score, and returns the next event to be played.
+    MidiEventList::iterator switchToPendingScore(
+        MidiOutputDevice &device, const MidiFile::LoadOptions &options,
+        MidiEventList &events, std::vector<int> &bar_start_ticks,
+        int &current_tick, TempoScale &tempo, int64_t &elapsed_us);
+
     void setIsPlaying(bool set);
     bool isPlaying() const;
 
     SettingsManager &mySettingsManager;
-    const Score &myScore;
+    /// A snapshot of the score, which shares its systems with the original.
+    Score myScore;
     ScoreLocation myStartLocation;
+    std::shared_ptr<const PerformanceOrder> myPerformanceOrder;
+    /// The time (in microseconds) to start playback at, if any.
+    boost::optional<int64_t> myStartTime;
     std::atomic<bool> myIsPlaying;
     std::atomic<bool> myMetronomeEnabled;
     /// The current playback speed (percent).
     std::atomic<int> myPlaybackSpeed;
+
+    /// An edited version of the score, which is waiting to be played.
+    std::mutex myPendingScoreMutex;
+    std::unique_ptr<Score> myPendingScore;
+    std::shared_ptr<const PerformanceOrder> myPendingPerformanceOrder;
+    std::atomic<bool> myHasPendingScore;
 };
 
 #endif
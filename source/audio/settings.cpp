@@ -29,6 +29,8 @@ const Setting<int> MidiVibratoLevel("midi/vibrato_level", 85);
 
 const Setting<int> MidiWideVibratoLevel("midi/wide_vibrato_level", 127);
 
+const Setting<bool> MidiFollowEdits("midi/follow_edits", true);
+
 const Setting<bool> MetronomeEnabled("midi/metronome_enabled", true);
 
 const Setting<int> MetronomePreset("midi/metronome_preset",
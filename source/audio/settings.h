@@ -28,6 +28,9 @@ namespace Settings
 
     extern const Setting<int> MidiVibratoLevel;
     extern const Setting<int> MidiWideVibratoLevel;
+    /// Whether changes to the score during playback are heard before playback
+    /// is restarted.
+    extern const Setting<bool> MidiFollowEdits;
 
     extern const Setting<bool> MetronomeEnabled;
     extern const Setting<int> MetronomePreset;
@@ -0,0 +1,418 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "batchconverter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem/operations.hpp>
+#include <boost/regex.hpp>
+#include <chrono>
+#include <formats/fileformatmanager.h>
+#include <map>
+#include <ostream>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <score/score.h>
+#include <score/utils/memoryusage.h>
+#include <thread>
+
+namespace fs = boost::filesystem;
+
+typedef rapidjson::Writer<rapidjson::StringBuffer> JSONWriter;
+
+ConversionInput::ConversionInput(const fs::path &file, const fs::path &root)
+    : myFile(file), myRoot(root)
+{
+}
+
+static std::string getExtension(const fs::path &path)
+{
+    std::string extension = path.extension().string();
+    if (!extension.empty())
+        extension.erase(0, 1); // Remove the leading '.'
+
+    return extension;
+}
+
+/// Converts a wildcard pattern into an equivalent regular expression.
+static boost::regex wildcardToRegex(const std::string &pattern)
+{
+    std::string expr;
+    for (char c : pattern)
+    {
+        switch (c)
+        {
+        case '*':
+            expr += ".*";
+            break;
+        case '?':
+            expr += '.';
+            break;
+        default:
+            if (std::string("\\^$.|+()[]{}").find(c) != std::string::npos)
+                expr += '\\';
+            expr += c;
+            break;
+        }
+    }
+
+    return boost::regex(expr);
+}
+
+static void findInDirectory(const FileFormatManager &manager,
+                            const fs::path &dir, const boost::regex *pattern,
+                            bool recursive,
+                            std::vector<ConversionInput> &inputs)
+{
+    auto addFile = [&](const fs::path &file) {
+        if (!fs::is_regular_file(file) ||
+            !manager.canImport(getExtension(file)))
+        {
+            return;
+        }
+
+        if (pattern &&
+            !boost::regex_match(file.filename().string(), *pattern))
+        {
+            return;
+        }
+
+        inputs.emplace_back(file, dir);
+    };
+
+    if (recursive)
+    {
+        for (fs::recursive_directory_iterator it(dir), end; it != end; ++it)
+            addFile(it->path());
+    }
+    else
+    {
+        for (fs::directory_iterator it(dir), end; it != end; ++it)
+            addFile(it->path());
+    }
+}
+
+std::vector<ConversionInput> findConversionInputs(
+    const FileFormatManager &manager, const std::vector<std::string> &args,
+    bool recursive)
+{
+    std::vector<ConversionInput> inputs;
+
+    for (const std::string &arg : args)
+    {
+        const fs::path path(arg);
+
+        if (arg.find_first_of("*?") != std::string::npos)
+        {
+            // Wildcards are only supported in the filename.
+            fs::path dir = path.parent_path();
+            if (dir.empty())
+                dir = ".";
+
+            const boost::regex pattern =
+                wildcardToRegex(path.filename().string());
+            findInDirectory(manager, dir, &pattern, recursive, inputs);
+        }
+        else if (fs::is_directory(path))
+            findInDirectory(manager, path, nullptr, recursive, inputs);
+        else if (fs::is_regular_file(path))
+        {
+            if (!manager.canImport(getExtension(path)))
+                throw std::runtime_error("Unsupported input format: " + arg);
+
+            inputs.emplace_back(path, path.parent_path());
+        }
+        else
+            throw std::runtime_error("File not found: " + arg);
+    }
+
+    // Sort the inputs so that the output order doesn't depend on the
+    // filesystem.
+    std::sort(inputs.begin(), inputs.end(),
+              [](const ConversionInput &a, const ConversionInput &b) {
+                  return a.myFile < b.myFile;
+              });
+
+    return inputs;
+}
+
+/// Returns the path of the file relative to the root directory.
+static fs::path getRelativePath(const fs::path &file, const fs::path &root)
+{
+    auto fileIt = file.begin();
+    for (auto rootIt = root.begin();
+         rootIt != root.end() && fileIt != file.end() && *rootIt == *fileIt;
+         ++rootIt, ++fileIt)
+    {
+    }
+
+    fs::path relative;
+    for (; fileIt != file.end(); ++fileIt)
+        relative /= *fileIt;
+
+    return relative;
+}
+
+/// Writes the number of bytes used by each part of the score.
+static void writeMemoryUsage(JSONWriter &writer,
+                             const ScoreUtils::MemoryUsage &memory)
+{
+    writer.Key("memory_bytes");
+    writer.StartObject();
+    writer.Key("score");
+    writer.Uint64(memory.myScore);
+    writer.Key("systems");
+    writer.Uint64(memory.mySystems);
+    writer.Key("staves");
+    writer.Uint64(memory.myStaves);
+    writer.Key("voices");
+    writer.Uint64(memory.myVoices);
+    writer.Key("positions");
+    writer.Uint64(memory.myPositions);
+    writer.Key("notes");
+    writer.Uint64(memory.myNotes);
+    writer.Key("total");
+    writer.Uint64(memory.getTotal());
+    writer.EndObject();
+}
+
+BatchConverter::Options::Options()
+    : myNumThreads(std::max(1u, std::thread::hardware_concurrency())),
+      myForce(false),
+      myReportMemory(false)
+{
+}
+
+BatchConverter::BatchConverter(const SettingsManager &settings,
+                               const Options &options, std::ostream &log)
+    : mySettings(settings), myOptions(options), myLog(log)
+{
+}
+
+int BatchConverter::run(const std::vector<ConversionInput> &inputs)
+{
+    // Inputs that share an output file can't be converted in parallel, and
+    // the result would depend on which one finished last.
+    const std::vector<bool> conflicts = findOutputConflicts(inputs);
+
+    std::atomic<size_t> nextInput(0);
+    std::atomic<int> numFailures(static_cast<int>(
+        std::count(conflicts.begin(), conflicts.end(), true)));
+
+    auto worker = [&]() {
+        // The importers and exporters aren't shared between threads. Each
+        // file is already converted on its own worker thread, so the
+        // importers don't start any more threads.
+        FileFormatManager manager(mySettings);
+        manager.setNumImportThreads(1);
+
+        size_t i;
+        while ((i = nextInput++) < inputs.size())
+        {
+            if (!conflicts[i] && !convert(manager, inputs[i]))
+                ++numFailures;
+        }
+    };
+
+    const unsigned int numThreads = std::max(
+        1u, std::min<unsigned int>(myOptions.myNumThreads, inputs.size()));
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numThreads; ++i)
+        threads.emplace_back(worker);
+
+    // Use the current thread as one of the workers.
+    worker();
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    return numFailures;
+}
+
+fs::path BatchConverter::getOutputPath(const ConversionInput &input,
+                                       const std::string &extension) const
+{
+    const fs::path outputDir =
+        (myOptions.myOutputDir.empty() ? input.myRoot : myOptions.myOutputDir) /
+        getRelativePath(input.myFile.parent_path(), input.myRoot);
+
+    fs::path output = outputDir / input.myFile.stem();
+    output += "." + extension;
+    return output;
+}
+
+std::vector<bool> BatchConverter::findOutputConflicts(
+    const std::vector<ConversionInput> &inputs)
+{
+    std::vector<bool> conflicts(inputs.size(), false);
+    std::map<fs::path, size_t> outputs;
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        for (const std::string &extension : myOptions.myFormats)
+        {
+            auto result =
+                outputs.emplace(getOutputPath(inputs[i], extension), i);
+            if (!result.second && result.first->second != i)
+            {
+                conflicts[i] = true;
+                conflicts[result.first->second] = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        if (!conflicts[i])
+            continue;
+
+        rapidjson::StringBuffer buffer;
+        JSONWriter writer(buffer);
+        writer.StartObject();
+        writer.Key("input");
+        writer.String(inputs[i].myFile.string().c_str());
+        writer.Key("status");
+        writer.String("error");
+        writer.Key("error");
+        writer.String("Another input has the same output file");
+        writer.EndObject();
+        writeLog(buffer.GetString());
+    }
+
+    return conflicts;
+}
+
+bool BatchConverter::convert(FileFormatManager &manager,
+                             const ConversionInput &input)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    rapidjson::StringBuffer buffer;
+    JSONWriter writer(buffer);
+    writer.StartObject();
+    writer.Key("input");
+    writer.String(input.myFile.string().c_str());
+
+    std::string error;
+    bool skipped = true;
+    double importTime = 0;
+    double exportTime = 0;
+    PhaseTimings phases;
+    ScoreUtils::MemoryUsage memory;
+
+    try
+    {
+        std::vector<fs::path> outputs;
+        for (const std::string &extension : myOptions.myFormats)
+        {
+            fs::path output = getOutputPath(input, extension);
+            if (myOptions.myForce || !isUpToDate(input.myFile, output))
+                outputs.push_back(output);
+        }
+
+        if (!outputs.empty())
+        {
+            skipped = false;
+
+            auto start = Clock::now();
+
+            Score score;
+            manager.importFile(score, input.myFile,
+                               *manager.findFormat(getExtension(input.myFile)));
+
+            auto end = Clock::now();
+            importTime =
+                std::chrono::duration<double, std::milli>(end - start).count();
+            phases = manager.getLastImportTimings();
+
+            if (myOptions.myReportMemory)
+                memory = ScoreUtils::measureMemory(score);
+
+            start = end;
+            for (const fs::path &output : outputs)
+            {
+                if (!output.parent_path().empty())
+                    fs::create_directories(output.parent_path());
+
+                manager.exportFile(score, output,
+                                   *manager.findFormat(getExtension(output)));
+            }
+
+            exportTime = std::chrono::duration<double, std::milli>(
+                             Clock::now() - start).count();
+        }
+    }
+    catch (const std::exception &e)
+    {
+        error = e.what();
+    }
+
+    writer.Key("status");
+    writer.String(!error.empty() ? "error" : (skipped ? "skipped" : "ok"));
+
+    if (!skipped)
+    {
+        writer.Key("import_ms");
+        writer.Double(importTime);
+        writer.Key("export_ms");
+        writer.Double(exportTime);
+
+        if (!phases.empty())
+        {
+            writer.Key("import_phases_ms");
+            writer.StartObject();
+            for (const auto &phase : phases)
+            {
+                writer.Key(phase.first.c_str());
+                writer.Double(phase.second);
+            }
+            writer.EndObject();
+        }
+
+        if (myOptions.myReportMemory)
+            writeMemoryUsage(writer, memory);
+    }
+
+    if (!error.empty())
+    {
+        writer.Key("error");
+        writer.String(error.c_str());
+    }
+
+    writer.EndObject();
+    writeLog(buffer.GetString());
+
+    return error.empty();
+}
+
+bool BatchConverter::isUpToDate(const fs::path &input, const fs::path &output)
+{
+    boost::system::error_code ec;
+    const std::time_t outputTime = fs::last_write_time(output, ec);
+    if (ec)
+        return false;
+
+    return outputTime > fs::last_write_time(input);
+}
+
+void BatchConverter::writeLog(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(myLogMutex);
+    myLog << line << std::endl;
+}
@@ -0,0 +1,103 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CONVERT_BATCHCONVERTER_H
+#define CONVERT_BATCHCONVERTER_H
+
+#include <boost/filesystem/path.hpp>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FileFormatManager;
+class SettingsManager;
+
+/// A file to be converted.
+struct ConversionInput
+{
+    ConversionInput(const boost::filesystem::path &file,
+                    const boost::filesystem::path &root);
+
+    boost::filesystem::path myFile;
+    /// The directory that the input was found in. The file's path relative to
+    /// this directory is preserved in the output directory.
+    boost::filesystem::path myRoot;
+};
+
+/// Expands a list of files, directories, or wildcard patterns (e.g.
+/// "songs/*.gp5") into the files that should be converted. Directories are
+/// searched for any file that has an importer.
+/// @throw std::runtime_error if an argument does not exist, or is a file that
+/// cannot be imported.
+std::vector<ConversionInput> findConversionInputs(
+    const FileFormatManager &manager, const std::vector<std::string> &args,
+    bool recursive);
+
+/// Converts files to one or more output formats using a pool of worker
+/// threads. One JSON object is written per input file, on a separate line,
+/// with the status of the conversion and the time taken.
+class BatchConverter
+{
+public:
+    struct Options
+    {
+        Options();
+
+        boost::filesystem::path myOutputDir;
+        /// Output file extensions (e.g. "pt2", "mid").
+        std::vector<std::string> myFormats;
+        unsigned int myNumThreads;
+        /// If false, outputs that are newer than their input are skipped.
+        bool myForce;
+        /// If true, the memory used by each imported score is reported.
+        bool myReportMemory;
+    };
+
+    BatchConverter(const SettingsManager &settings, const Options &options,
+                   std::ostream &log);
+
+    /// Converts all of the inputs, and returns the number of failures.
+    int run(const std::vector<ConversionInput> &inputs);
+
+private:
+    /// Returns the path of the output file with the given extension.
+    boost::filesystem::path getOutputPath(const ConversionInput &input,
+                                          const std::string &extension) const;
+
+    /// Finds the inputs that would be written to the same output file as
+    /// another input (e.g. "song.gp5" and "song.ptb"), and reports them as
+    /// errors.
+    std::vector<bool> findOutputConflicts(
+        const std::vector<ConversionInput> &inputs);
+
+    /// Returns false if the conversion failed.
+    bool convert(FileFormatManager &manager, const ConversionInput &input);
+
+    /// Returns true if the output exists and is newer than the input.
+    static bool isUpToDate(const boost::filesystem::path &input,
+                           const boost::filesystem::path &output);
+
+    void writeLog(const std::string &line);
+
+    const SettingsManager &mySettings;
+    const Options myOptions;
+    std::ostream &myLog;
+    std::mutex myLogMutex;
+};
+
+#endif
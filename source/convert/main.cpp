@@ -0,0 +1,124 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <app/settingsmanager.h>
+#include <boost/program_options.hpp>
+#include <convert/batchconverter.h>
+#include <formats/fileformatmanager.h>
+#include <formats/settings.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description desc(
+        "Usage: pte-convert [options] inputs...\n"
+        "Converts files, directories, or wildcard patterns to other formats.\n"
+        "The result for each file is printed as a line of JSON.\n\nOptions");
+
+    BatchConverter::Options options;
+    std::vector<std::string> inputArgs;
+    bool recursive = false;
+    bool indexed = false;
+
+    try
+    {
+        std::string outputDir;
+
+        desc.add_options()
+            ("help,h", "Displays this help.")
+            ("format,f",
+             po::value<std::vector<std::string>>(&options.myFormats)
+                 ->required(),
+             "An output format (e.g. pt2, mid). May be repeated.")
+            ("output,o", po::value<std::string>(&outputDir),
+             "The output directory. By default, files are written alongside "
+             "the inputs.")
+            ("jobs,j",
+             po::value<unsigned int>(&options.myNumThreads)
+                 ->default_value(options.myNumThreads),
+             "The number of files to convert in parallel.")
+            ("recursive,r", po::bool_switch(&recursive),
+             "Search directories recursively.")
+            ("force", po::bool_switch(&options.myForce),
+             "Convert files even if the outputs are up to date.")
+            ("memory", po::bool_switch(&options.myReportMemory),
+             "Report the memory used by each file after it is imported.")
+            ("indexed", po::bool_switch(&indexed),
+             "Save .pt2 files in the indexed format, which can be opened "
+             "without loading every system.")
+            ("inputs", po::value<std::vector<std::string>>(&inputArgs)
+                           ->required(),
+             "The files to convert.");
+        po::positional_options_description p;
+        p.add("inputs", -1);
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv)
+                      .options(desc)
+                      .positional(p)
+                      .run(),
+                  vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        po::notify(vm);
+        options.myOutputDir = outputDir;
+    }
+    catch (po::error &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Use the default settings for e.g. the MIDI exporter.
+    SettingsManager settings;
+    {
+        auto handle = settings.getWriteHandle();
+        handle->set(Settings::IndexedPowerTabFiles, indexed);
+    }
+
+    std::vector<ConversionInput> inputs;
+    try
+    {
+        FileFormatManager manager(settings);
+
+        for (const std::string &format : options.myFormats)
+        {
+            if (!manager.canExport(format))
+                throw std::runtime_error("Unsupported output format: " + format);
+        }
+
+        inputs = findConversionInputs(manager, inputArgs, recursive);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    BatchConverter converter(settings, options, std::cout);
+    const int numFailures = converter.run(inputs);
+
+    return numFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
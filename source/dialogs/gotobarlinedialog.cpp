@@ -19,28 +19,20 @@
 #include "ui_gotobarlinedialog.h"
 
 #include <score/score.h>
+#include <score/utils/navigationindex.h>
 
-GoToBarlineDialog::GoToBarlineDialog(QWidget *parent, const Score &score)
+GoToBarlineDialog::GoToBarlineDialog(QWidget *parent, const Score &score,
+                                     const NavigationIndex &index)
     : QDialog(parent),
-      ui(new Ui::GoToBarlineDialog)
+      ui(new Ui::GoToBarlineDialog),
+      myScore(score),
+      myIndex(index)
 {
     ui->setupUi(this);
 
-    for (int system_index = 0; system_index < score.getSystems().size();
-         ++system_index)
-    {
-        const System &system = score.getSystems()[system_index];
-        // Index all barlines except for the end bar.
-        for (int i = 0; i < system.getBarlines().size() - 1; ++i)
-        {
-            myLocations.push_back(ScoreLocation(
-                score, system_index, 0, system.getBarlines()[i].getPosition()));
-        }
-    }
-
     ui->barlineSpinBox->setValue(1);
     ui->barlineSpinBox->setMinimum(1);
-    ui->barlineSpinBox->setMaximum(static_cast<int>(myLocations.size()));
+    ui->barlineSpinBox->setMaximum(myIndex.getBarCount());
 
     ui->barlineSpinBox->selectAll();
 }
@@ -53,6 +45,8 @@ GoToBarlineDialog::~GoToBarlineDialog()
 /// Returns the location of the selected barline.
 ScoreLocation GoToBarlineDialog::getLocation() const
 {
-    const int index = ui->barlineSpinBox->value();
-    return myLocations.at(index - 1);
+    const SystemLocation &location =
+        myIndex.getBarLocation(ui->barlineSpinBox->value());
+    return ScoreLocation(myScore, location.getSystem(), 0,
+                         location.getPosition());
 }
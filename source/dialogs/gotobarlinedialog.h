@@ -20,18 +20,19 @@
 
 #include <QDialog>
 #include <score/scorelocation.h>
-#include <vector>
 
 namespace Ui {
 class GoToBarlineDialog;
 }
 
+class NavigationIndex;
 class Score;
 
 class GoToBarlineDialog : public QDialog
 {
 public:
-    explicit GoToBarlineDialog(QWidget *parent, const Score &score);
+    GoToBarlineDialog(QWidget *parent, const Score &score,
+                      const NavigationIndex &index);
     ~GoToBarlineDialog();
 
     /// Returns the location of the selected barline.
@@ -39,7 +40,8 @@ public:
 
 private:
     Ui::GoToBarlineDialog *ui;
-    std::vector<ScoreLocation> myLocations;
+    const Score &myScore;
+    const NavigationIndex &myIndex;
 };
 
 #endif
@@ -3,41 +3,26 @@
 
 #include <score/score.h>
 #include <score/scorelocation.h>
-
-// The ScoreLocation class cannot be used with QVariant since it doesn't
-// have a default constructor. So, we use a pair of ints to store the system
-// and position.
-typedef std::pair<int, int> SystemAndPosition;
-Q_DECLARE_METATYPE(SystemAndPosition)
+#include <score/utils/navigationindex.h>
 
 GoToRehearsalSignDialog::GoToRehearsalSignDialog(QWidget *parent,
-                                                 const Score &score)
+                                                 const Score &score,
+                                                 const NavigationIndex &index)
     : QDialog(parent),
       ui(new Ui::GoToRehearsalSignDialog),
-      myScore(score)
+      myScore(score),
+      myIndex(index)
 {
     ui->setupUi(this);
 
     // Add all of the rehearsal signs in the score to the list.
-    int systemIndex = 0;
-    for (const System &system : score.getSystems())
+    for (const NavigationIndex::RehearsalSignEntry &sign :
+         myIndex.getRehearsalSigns())
     {
-        for (const Barline &barline : system.getBarlines())
-        {
-            if (barline.hasRehearsalSign())
-            {
-                SystemAndPosition location = std::make_pair(
-                            systemIndex, barline.getPosition());
-                const RehearsalSign &sign = barline.getRehearsalSign();
-
-                ui->rehearsalSignComboBox->addItem(QString("%1 -- %2").arg(
-                                QString::fromStdString(sign.getLetters()),
-                                QString::fromStdString(sign.getDescription())),
-                            QVariant::fromValue(location));
-            }
-        }
-
-        ++systemIndex;
+        ui->rehearsalSignComboBox->addItem(
+            QString("%1 -- %2").arg(
+                QString::fromStdString(sign.myLetters),
+                QString::fromStdString(sign.myDescription)));
     }
 }
 
@@ -51,10 +36,10 @@ ScoreLocation GoToRehearsalSignDialog::getLocation() const
     const int index = ui->rehearsalSignComboBox->currentIndex();
     Q_ASSERT(index >= 0);
 
-    SystemAndPosition location = ui->rehearsalSignComboBox->itemData(
-                index).value<SystemAndPosition>();
-
-    return ScoreLocation(myScore, location.first, 0, location.second);
+    const SystemLocation &location =
+        myIndex.getRehearsalSigns().at(index).myLocation;
+    return ScoreLocation(myScore, location.getSystem(), 0,
+                         location.getPosition());
 }
 
 void GoToRehearsalSignDialog::accept()
@@ -7,6 +7,7 @@ namespace Ui {
 class GoToRehearsalSignDialog;
 }
 
+class NavigationIndex;
 class Score;
 class ScoreLocation;
 
@@ -15,7 +16,8 @@ class GoToRehearsalSignDialog : public QDialog
     Q_OBJECT
 
 public:
-    explicit GoToRehearsalSignDialog(QWidget *parent, const Score &score);
+    GoToRehearsalSignDialog(QWidget *parent, const Score &score,
+                            const NavigationIndex &index);
     ~GoToRehearsalSignDialog();
 
     /// Returns the location of the selected rehearsal sign.
@@ -27,6 +29,7 @@ public slots:
 private:
     Ui::GoToRehearsalSignDialog *ui;
     const Score &myScore;
+    const NavigationIndex &myIndex;
 };
 
 #endif
@@ -0,0 +1,96 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "memoryusagedialog.h"
+
+#include <app/documentmanager.h>
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <score/utils/memoryusage.h>
+
+static QTableWidgetItem *createSizeItem(size_t bytes)
+{
+    auto item = new QTableWidgetItem(
+        QString::number(bytes / 1024.0, 'f', 1));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+MemoryUsageDialog::MemoryUsageDialog(QWidget *parent,
+                                     DocumentManager &manager)
+    : QDialog(parent)
+{
+    setWindowTitle(tr("Memory Usage"));
+    setModal(true);
+
+    auto table = new QTableWidget(this);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setColumnCount(8);
+    table->setHorizontalHeaderLabels(
+        { tr("Score (KB)"), tr("Systems (KB)"), tr("Staves (KB)"),
+          tr("Voices (KB)"), tr("Positions (KB)"), tr("Notes (KB)"),
+          tr("Total (KB)"), tr("Unloaded Systems") });
+
+    const int count = static_cast<int>(manager.getDocumentListSize());
+    table->setRowCount(count);
+
+    QStringList names;
+    for (int i = 0; i < count; ++i)
+    {
+        const Document &doc = manager.getDocument(i);
+        if (doc.hasFilename())
+        {
+            names << QString::fromStdString(
+                doc.getFilename().filename().string());
+        }
+        else
+            names << tr("Untitled");
+
+        // Unloaded systems are not loaded just to measure them.
+        const Score &score = doc.getScore();
+        const ScoreUtils::MemoryUsage usage = ScoreUtils::measureMemory(score);
+
+        int column = 0;
+        table->setItem(i, column++, createSizeItem(usage.myScore));
+        table->setItem(i, column++, createSizeItem(usage.mySystems));
+        table->setItem(i, column++, createSizeItem(usage.myStaves));
+        table->setItem(i, column++, createSizeItem(usage.myVoices));
+        table->setItem(i, column++, createSizeItem(usage.myPositions));
+        table->setItem(i, column++, createSizeItem(usage.myNotes));
+        table->setItem(i, column++, createSizeItem(usage.getTotal()));
+
+        auto unloaded = new QTableWidgetItem(
+            QString::number(score.getUnloadedSystemCount()));
+        unloaded->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        table->setItem(i, column++, unloaded);
+    }
+
+    table->setVerticalHeaderLabels(names);
+    table->resizeColumnsToContents();
+    table->horizontalHeader()->setStretchLastSection(true);
+
+    auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+    connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject()));
+
+    auto layout = new QVBoxLayout(this);
+    layout->addWidget(table);
+    layout->addWidget(buttonBox);
+    setLayout(layout);
+    resize(800, 300);
+}
@@ -0,0 +1,35 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef DIALOGS_MEMORYUSAGEDIALOG_H
+#define DIALOGS_MEMORYUSAGEDIALOG_H
+
+#include <QDialog>
+
+class DocumentManager;
+
+/// Displays a breakdown of the memory used by each open document, for
+/// tracking down increases in the size of the score's data structures.
+class MemoryUsageDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    MemoryUsageDialog(QWidget *parent, DocumentManager &manager);
+};
+
+#endif
@@ -70,6 +70,10 @@ PreferencesDialog::PreferencesDialog(QWidget *parent,
 
     ui->countInVolumeSpinBox->setRange(0, 127);
 
+    ui->undoMemoryLimitSpinBox->setRange(0, 4096);
+    ui->undoMemoryLimitSpinBox->setSuffix(tr(" MB"));
+    ui->undoMemoryLimitSpinBox->setSpecialValueText(tr("Unlimited"));
+
     loadCurrentSettings();
 }
 
@@ -99,6 +103,9 @@ void PreferencesDialog::loadCurrentSettings()
     ui->wideVibratoStrengthSpinBox->setValue(
         settings->get(Settings::MidiWideVibratoLevel));
 
+    ui->followEditsCheckBox->setChecked(
+        settings->get(Settings::MidiFollowEdits));
+
     ui->metronomeEnabledCheckBox->setChecked(
         settings->get(Settings::MetronomeEnabled));
 
@@ -122,6 +129,9 @@ void PreferencesDialog::loadCurrentSettings()
     ui->openInNewWindowCheckBox->setChecked(
         settings->get(Settings::OpenFilesInNewWindow));
 
+    ui->undoMemoryLimitSpinBox->setValue(
+        settings->get(Settings::UndoMemoryLimit));
+
     ui->defaultInstrumentNameLineEdit->setText(
         QString::fromStdString(settings->get(Settings::DefaultInstrumentName)));
     ui->defaultPresetComboBox->setCurrentIndex(
@@ -150,6 +160,9 @@ void PreferencesDialog::accept()
     settings->set(Settings::MidiWideVibratoLevel,
                   ui->wideVibratoStrengthSpinBox->value());
 
+    settings->set(Settings::MidiFollowEdits,
+                  ui->followEditsCheckBox->isChecked());
+
     settings->set(Settings::MetronomeEnabled,
                   ui->metronomeEnabledCheckBox->isChecked());
 
@@ -173,6 +186,9 @@ void PreferencesDialog::accept()
     settings->set(Settings::OpenFilesInNewWindow,
                   ui->openInNewWindowCheckBox->isChecked());
 
+    settings->set(Settings::UndoMemoryLimit,
+                  ui->undoMemoryLimitSpinBox->value());
+
     settings->set(Settings::DefaultInstrumentName,
                   ui->defaultInstrumentNameLineEdit->text().toStdString());
 
@@ -0,0 +1,61 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bytereader.h"
+
+#include <algorithm>
+#include <formats/fileformat.h>
+
+ByteReader::ByteReader(const char *data, size_t size)
+    : myData(data), mySize(size), myPosition(0)
+{
+}
+
+void ByteReader::read(char *dest, size_t n)
+{
+    require(n);
+    std::memcpy(dest, myData + myPosition, n);
+    myPosition += n;
+}
+
+std::string ByteReader::readString(size_t length)
+{
+    require(length);
+    std::string str(myData + myPosition, length);
+    myPosition += length;
+    return str;
+}
+
+void ByteReader::skip(size_t n)
+{
+    // Like seeking past the end of a stream, this is only an error if we
+    // then try to read something.
+    myPosition += std::min(n, remaining());
+}
+
+void ByteReader::seek(size_t offset)
+{
+    if (offset > mySize)
+        throwUnexpectedEnd();
+
+    myPosition = offset;
+}
+
+void ByteReader::throwUnexpectedEnd()
+{
+    throw FileFormatException("Unexpected end of file");
+}
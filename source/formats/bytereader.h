@@ -0,0 +1,118 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FORMATS_BYTEREADER_H
+#define FORMATS_BYTEREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/// A bounds-checked cursor over a contiguous block of bytes, such as a
+/// memory-mapped file. The reader does not own the data.
+/// Multi-byte values are decoded as little-endian.
+class ByteReader
+{
+public:
+    ByteReader(const char *data, size_t size);
+
+    /// Reads simple data (e.g. uint32_t, int16_t).
+    /// @throw FileFormatException if there is not enough data left.
+    template <typename T>
+    T read();
+
+    /// Copies the next n bytes into the destination buffer.
+    /// @throw FileFormatException if there is not enough data left.
+    void read(char *dest, size_t n);
+
+    /// Reads a string of the given length.
+    std::string readString(size_t length);
+
+    /// Advances by the given number of bytes, stopping at the end of the data.
+    void skip(size_t n);
+    /// Moves to the given offset from the start of the data.
+    void seek(size_t offset);
+
+    size_t position() const { return myPosition; }
+    size_t size() const { return mySize; }
+    size_t remaining() const { return mySize - myPosition; }
+    bool atEnd() const { return myPosition >= mySize; }
+
+    /// Returns a pointer to the start of the data.
+    const char *data() const { return myData; }
+    /// Returns a pointer to the current position.
+    const char *current() const { return myData + myPosition; }
+
+private:
+    /// @throw FileFormatException if fewer than n bytes remain.
+    void require(size_t n) const
+    {
+        if (n > mySize - myPosition)
+            throwUnexpectedEnd();
+    }
+
+    [[noreturn]] static void throwUnexpectedEnd();
+
+    template <typename T>
+    static T load(const unsigned char *bytes, std::true_type /* integral */)
+    {
+        typedef typename std::make_unsigned<T>::type Unsigned;
+
+        Unsigned value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            value |= static_cast<Unsigned>(bytes[i]) << (8 * i);
+
+        return static_cast<T>(value);
+    }
+
+    template <typename T>
+    static T load(const unsigned char *bytes, std::false_type /* integral */)
+    {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    const char *myData;
+    size_t mySize;
+    size_t myPosition;
+};
+
+template <typename T>
+inline T ByteReader::read()
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "T must be a trivially copyable type");
+
+    require(sizeof(T));
+    const unsigned char *bytes =
+        reinterpret_cast<const unsigned char *>(myData + myPosition);
+    myPosition += sizeof(T);
+
+    return load<T>(bytes, std::is_integral<T>());
+}
+
+template <>
+inline bool ByteReader::read<bool>()
+{
+    require(1);
+    return myData[myPosition++] != 0;
+}
+
+#endif
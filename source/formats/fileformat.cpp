@@ -18,6 +18,7 @@
 #include "fileformat.h"
 
 #include <algorithm>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 FileFormat::FileFormat(const std::string &name,
                        const std::vector<std::string> &fileExtensions)
@@ -58,7 +59,8 @@ bool FileFormat::contains(const std::string &extension) const
 }
 
 FileFormatImporter::FileFormatImporter(const FileFormat &format) :
-    myFormat(format)
+    myFormat(format),
+    myNumThreads(1)
 {
 }
 
@@ -71,6 +73,50 @@ FileFormat FileFormatImporter::fileFormat() const
     return myFormat;
 }
 
+const PhaseTimings &FileFormatImporter::getPhaseTimings() const
+{
+    return myPhaseTimings;
+}
+
+void FileFormatImporter::setNumThreads(unsigned int numThreads)
+{
+    myNumThreads = numThreads;
+}
+
+unsigned int FileFormatImporter::getNumThreads() const
+{
+    return myNumThreads;
+}
+
+void FileFormatImporter::resetPhaseTimings()
+{
+    myPhaseTimings.clear();
+    myPhaseStart = Clock::now();
+}
+
+void FileFormatImporter::endPhase(const std::string &name)
+{
+    const Clock::time_point end = Clock::now();
+    myPhaseTimings.emplace_back(
+        name,
+        std::chrono::duration<double, std::milli>(end - myPhaseStart).count());
+    myPhaseStart = end;
+}
+
+boost::iostreams::mapped_file_source FileFormatImporter::mapFile(
+    const boost::filesystem::path &filename)
+{
+    try
+    {
+        return boost::iostreams::mapped_file_source(filename);
+    }
+    catch (const std::exception &e)
+    {
+        throw FileFormatException("Could not open " + filename.string() +
+                                  ": " + e.what());
+    }
+}
+
 FileFormatException::FileFormatException(const std::string& error)
     : std::runtime_error(error)
 {
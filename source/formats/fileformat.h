@@ -19,12 +19,20 @@
 #define FORMATS_FILEFORMAT_H
 
 #include <boost/filesystem/path.hpp>
+#include <chrono>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 class Score;
 
+namespace boost {
+namespace iostreams {
+class mapped_file_source;
+}
+}
+
 class FileFormat
 {
 public:
@@ -48,6 +56,10 @@ private:
     std::vector<std::string> myFileExtensions;
 };
 
+/// The time taken (in milliseconds) by each phase of an import, such as
+/// reading the file or converting it to a score.
+typedef std::vector<std::pair<std::string, double>> PhaseTimings;
+
 /// Base class for all file format importers.
 class FileFormatImporter
 {
@@ -63,8 +75,38 @@ public:
     /// Returns the file format corresponding to this importer.
     FileFormat fileFormat() const;
 
+    /// Returns the timings recorded during the most recent import, if the
+    /// importer records them.
+    const PhaseTimings &getPhaseTimings() const;
+
+    /// Sets the number of threads that may be used to process the imported
+    /// score (e.g. to reformat its systems). By default, only the calling
+    /// thread is used.
+    void setNumThreads(unsigned int numThreads);
+
+protected:
+    unsigned int getNumThreads() const;
+
+    /// Memory-maps the file so that binary formats can be parsed in place
+    /// with a ByteReader rather than through a std::istream.
+    /// @throw FileFormatException
+    static boost::iostreams::mapped_file_source mapFile(
+        const boost::filesystem::path &filename);
+
+    /// Clears the phase timings and starts timing the first phase.
+    void resetPhaseTimings();
+
+    /// Records the time taken by a phase of the import, measured from the end
+    /// of the previous phase.
+    void endPhase(const std::string &name);
+
 private:
+    typedef std::chrono::high_resolution_clock Clock;
+
     const FileFormat myFormat;
+    unsigned int myNumThreads;
+    PhaseTimings myPhaseTimings;
+    Clock::time_point myPhaseStart;
 };
 
 /// Base class for all file format exporters.
@@ -17,6 +17,7 @@
   
 #include "fileformatmanager.h"
 
+#include <algorithm>
 #include <formats/gpx/gpximporter.h>
 #include <formats/guitar_pro/guitarproimporter.h>
 #include <formats/midi/midiexporter.h>
@@ -31,7 +32,7 @@ FileFormatManager::FileFormatManager(const SettingsManager &settings_manager)
     myImporters.emplace_back(new GuitarProImporter());
     myImporters.emplace_back(new GpxImporter());
 
-    myExporters.emplace_back(new PowerTabExporter());
+    myExporters.emplace_back(new PowerTabExporter(settings_manager));
     myExporters.emplace_back(new MidiExporter(settings_manager));
 }
 
@@ -53,6 +54,22 @@ boost::optional<FileFormat> FileFormatManager::findFormat(
     return boost::none;
 }
 
+bool FileFormatManager::canImport(const std::string &extension) const
+{
+    return std::any_of(myImporters.begin(), myImporters.end(),
+                       [&](const std::unique_ptr<FileFormatImporter> &importer) {
+                           return importer->fileFormat().contains(extension);
+                       });
+}
+
+bool FileFormatManager::canExport(const std::string &extension) const
+{
+    return std::any_of(myExporters.begin(), myExporters.end(),
+                       [&](const std::unique_ptr<FileFormatExporter> &exporter) {
+                           return exporter->fileFormat().contains(extension);
+                       });
+}
+
 std::string FileFormatManager::importFileFilter() const
 {
     std::string filterAll = "All Supported Formats (";
@@ -81,7 +98,9 @@ void FileFormatManager::importFile(Score &score,
     {
         if (importer->fileFormat() == format)
         {
+            myLastImportTimings.clear();
             importer->load(filename, score);
+            myLastImportTimings = importer->getPhaseTimings();
             return;
         }
     }
@@ -89,6 +108,17 @@ void FileFormatManager::importFile(Score &score,
     throw std::runtime_error("Unknown file format");
 }
 
+const PhaseTimings &FileFormatManager::getLastImportTimings() const
+{
+    return myLastImportTimings;
+}
+
+void FileFormatManager::setNumImportThreads(unsigned int numThreads)
+{
+    for (auto &importer : myImporters)
+        importer->setNumThreads(numThreads);
+}
+
 std::string FileFormatManager::exportFileFilter() const
 {
     std::string filter;
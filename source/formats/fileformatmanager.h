@@ -37,6 +37,12 @@ public:
     /// Returns the file format corresponding to the given extension.
     boost::optional<FileFormat> findFormat(const std::string &extension) const;
 
+    /// Returns whether there is an importer for the given extension.
+    bool canImport(const std::string &extension) const;
+
+    /// Returns whether there is an exporter for the given extension.
+    bool canExport(const std::string &extension) const;
+
     /// Returns a correctly formatted file filter for a Qt file dialog.
     /// e.g. "FileType (*.ext1 *.ext2);;FileType2 (*.ext3)".
     std::string importFileFilter() const;
@@ -46,6 +52,14 @@ public:
     void importFile(Score &score, const boost::filesystem::path &filename,
                     const FileFormat &format);
 
+    /// Returns the timings for each phase of the most recent import, if the
+    /// importer records them.
+    const PhaseTimings &getLastImportTimings() const;
+
+    /// Sets the number of threads that each import may use.
+    /// @see FileFormatImporter::setNumThreads()
+    void setNumImportThreads(unsigned int numThreads);
+
     /// Returns a correctly formatted file filter for a Qt file dialog.
     std::string exportFileFilter() const;
 
@@ -63,6 +77,7 @@ private:
 
     std::vector<std::unique_ptr<FileFormatImporter>> myImporters;
     std::vector<std::unique_ptr<FileFormatExporter>> myExporters;
+    PhaseTimings myLastImportTimings;
 };
 
 #endif
@@ -18,35 +18,32 @@
 #include "bitstream.h"
 
 #include <cassert>
-#include <istream>
-#include "util.h"
+#include <formats/bytereader.h>
 
 static const uint32_t BYTE_LENGTH = 8;
 
-Gpx::BitStream::BitStream(std::istream &stream)
-    : myPosition(0)
+Gpx::BitStream::BitStream(const ByteReader &reader)
+    : myPosition(0),
+      myBytes(reinterpret_cast<const uint8_t *>(reader.current())),
+      mySize(reader.remaining())
 {
-    // Copy data from the stream into an internal buffer.
-    stream.seekg(0, std::ios::end);
-    myBytes.resize(stream.tellg());
-
-    stream.seekg(0, std::ios::beg);
-    stream.read(reinterpret_cast<char *>(&myBytes[0]), myBytes.size());
 }
 
 uint32_t Gpx::BitStream::readInt()
 {
     assert(myPosition % BYTE_LENGTH == 0);
 
-    const uint32_t value = Gpx::Util::readUInt(myBytes,
-                                               myPosition / BYTE_LENGTH);
+    ByteReader reader(reinterpret_cast<const char *>(myBytes), mySize);
+    reader.seek(myPosition / BYTE_LENGTH);
+
+    const uint32_t value = reader.read<uint32_t>();
     myPosition += sizeof(uint32_t) * BYTE_LENGTH;
     return value;
 }
 
 bool Gpx::BitStream::readBit()
 {
-    if (myPosition / BYTE_LENGTH >= myBytes.size())
+    if (myPosition / BYTE_LENGTH >= mySize)
         return 0;
 
     char byte = myBytes[myPosition / BYTE_LENGTH];
@@ -83,5 +80,5 @@ size_t Gpx::BitStream::getLocation() const
 
 bool Gpx::BitStream::isAtEnd() const
 {
-    return getLocation() >= (myBytes.size() - 1);
+    return getLocation() + 1 >= mySize;
 }
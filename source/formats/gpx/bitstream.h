@@ -18,9 +18,10 @@
 #ifndef FORMATS_GPX_BITSTREAM_H
 #define FORMATS_GPX_BITSTREAM_H
 
+#include <cstddef>
 #include <cstdint>
-#include <iosfwd>
-#include <vector>
+
+class ByteReader;
 
 namespace Gpx
 {
@@ -36,7 +37,9 @@ public:
         Reversed
     };
 
-    BitStream(std::istream &stream);
+    /// Reads from the remaining data in the given reader, which must outlive
+    /// the bit stream.
+    BitStream(const ByteReader &reader);
 
     /// Reads a 32-bit unsigned integer from the stream. This assumes that the
     /// stream position is exactly on the start of a byte.
@@ -58,7 +61,8 @@ private:
     /// The current position in the input (measured in bits).
     size_t myPosition;
     /// The compressed data being read.
-    std::vector<uint8_t> myBytes;
+    const uint8_t *myBytes;
+    size_t mySize;
 };
 
 }
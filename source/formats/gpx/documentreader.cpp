@@ -342,6 +342,7 @@ void Gpx::DocumentReader::readMasterBars(Score &score)
         {
             Staff &staff = system.getStaves()[i];
             int currentPos = (startPos != 0) ? startPos + 1 : 0;
+            std::vector<Position> positions;
 
             // TODO - import multiple voices.
             for (int beatId :
@@ -389,9 +390,11 @@ void Gpx::DocumentReader::readMasterBars(Score &score)
                     pos.setRest();
 
                 pos.setPosition(currentPos++);
-                staff.getVoices()[0].insertPosition(pos);
+                positions.push_back(std::move(pos));
             }
 
+            staff.getVoices()[0].insertPositions(std::move(positions));
+
             nextPos = std::max(nextPos, currentPos);
         }
 
@@ -31,10 +31,10 @@ enum ChunkHeader
 
 static const uint32_t SECTOR_SIZE = 0x1000;
 
-Gpx::FileSystem::FileSystem(std::istream &stream)
+Gpx::FileSystem::FileSystem(const ByteReader &reader)
 {
     // Decompress the input file and return the filesystem.
-    Gpx::BitStream input(stream);
+    Gpx::BitStream input(reader);
 
     const uint32_t BCFS_HEADER = 0x53464342;
     const uint32_t BCFZ_HEADER = 0x5a464342;
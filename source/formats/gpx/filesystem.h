@@ -19,11 +19,12 @@
 #define FORMATS_GPX_FILESYSTEM_H
 
 #include <cstdint>
-#include <iosfwd>
 #include <map>
 #include <string>
 #include <vector>
 
+class ByteReader;
+
 namespace Gpx
 {
 
@@ -33,7 +34,7 @@ namespace Gpx
 class FileSystem
 {
 public:
-    FileSystem(std::istream &stream);
+    FileSystem(const ByteReader &reader);
 
     const std::string &getFileContents(const std::string &filename) const;
 
@@ -23,7 +23,8 @@
 #include <score/score.h>
 #include <score/utils/scorepolisher.h>
 
-#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <formats/bytereader.h>
 
 GpxImporter::GpxImporter()
     : FileFormatImporter(FileFormat("Guitar Pro 6", { "gpx" }))
@@ -33,12 +34,13 @@ GpxImporter::GpxImporter()
 void GpxImporter::load(const boost::filesystem::path &filename, Score &score)
 {
     // Load the data, decompress, and open as XML document.
-    boost::filesystem::ifstream file(filename, std::ios::binary | std::ios::in);
-    Gpx::FileSystem fs(file);
+    const boost::iostreams::mapped_file_source file = mapFile(filename);
+    Gpx::FileSystem fs(ByteReader(file.data(), file.size()));
 
     Gpx::DocumentReader reader(fs.getFileContents("score.gpif"));
     reader.readScore(score);
 
-    ScoreUtils::polishScore(score);
+    ScoreUtils::polishScore(
+        score, ScoreUtils::ParallelOptions(getNumThreads()));
     ScoreUtils::addStandardFilters(score);
 }
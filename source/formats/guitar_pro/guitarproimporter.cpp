@@ -18,7 +18,7 @@
 #include "guitarproimporter.h"
 
 #include <boost/date_time/gregorian/gregorian_types.hpp>
-#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 #include <formats/guitar_pro/document.h>
 #include <formats/guitar_pro/inputstream.h>
@@ -37,8 +37,8 @@ GuitarProImporter::GuitarProImporter()
 void GuitarProImporter::load(const boost::filesystem::path &filename,
                              Score &score)
 {
-    boost::filesystem::ifstream in(filename, std::ios::binary | std::ios::in);
-    Gp::InputStream stream(in);
+    const boost::iostreams::mapped_file_source file = mapFile(filename);
+    Gp::InputStream stream(ByteReader(file.data(), file.size()));
 
     Gp::Document document;
     document.load(stream);
@@ -55,7 +55,8 @@ void GuitarProImporter::load(const boost::filesystem::path &filename,
     ScoreUtils::adjustRehearsalSigns(score);
 
     // Format the score.
-    ScoreUtils::polishScore(score);
+    ScoreUtils::polishScore(
+        score, ScoreUtils::ParallelOptions(getNumThreads()));
 }
 
 void GuitarProImporter::convertHeader(const Gp::Header &header, ScoreInfo &info)
@@ -243,6 +244,7 @@ void GuitarProImporter::convertIrregularGroupings(
     const std::vector<Gp::Beat> &beats, const std::vector<int> &positions,
     Voice &voice)
 {
+    std::vector<IrregularGrouping> groups;
     boost::optional<int> currentGroup;
     int startPos = -1;
     int numerator = -1;
@@ -279,9 +281,8 @@ void GuitarProImporter::convertIrregularGroupings(
                     const int notesPlayedOver = std::pow(
                         2, std::floor(std::log(*currentGroup) / std::log(2.0)));
 
-                    IrregularGrouping group(startPos, count, *currentGroup,
-                                            notesPlayedOver);
-                    voice.insertIrregularGrouping(group);
+                    groups.emplace_back(startPos, count, *currentGroup,
+                                        notesPlayedOver);
 
                     currentGroup.reset();
                 }
@@ -290,6 +291,8 @@ void GuitarProImporter::convertIrregularGroupings(
         else
             currentGroup.reset();
     }
+
+    voice.insertIrregularGroupings(std::move(groups));
 }
 
 void GuitarProImporter::convertScore(const Gp::Document &doc, Score &score)
@@ -350,14 +353,18 @@ void GuitarProImporter::convertScore(const Gp::Document &doc, Score &score)
                 // Start inserting notes after the barline.
                 int currentPos = (startPos != 0) ? startPos + 1 : 0;
                 Voice &voice = staff.getVoices()[v];
+                std::vector<Position> newPositions;
                 std::vector<int> positions;
 
                 for (const Gp::Beat &beat : gp_staff.myVoices[v])
                 {
-                    currentPos = convertBeat(beat, system, voice, currentPos);
+                    currentPos =
+                        convertBeat(beat, system, newPositions, currentPos);
                     positions.push_back(currentPos - 1);
                 }
 
+                voice.insertPositions(std::move(newPositions));
+
                 convertIrregularGroupings(gp_staff.myVoices[v], positions,
                                           voice);
 
@@ -389,7 +396,8 @@ void GuitarProImporter::convertScore(const Gp::Document &doc, Score &score)
 }
 
 int GuitarProImporter::convertBeat(const Gp::Beat &beat, System &system,
-                                   Voice &voice, int position)
+                                   std::vector<Position> &positions,
+                                   int position)
 {
     // Check for grace notes.
     {
@@ -423,7 +431,7 @@ int GuitarProImporter::convertBeat(const Gp::Beat &beat, System &system,
         if (!gracePos.getNotes().empty())
         {
             gracePos.setProperty(Position::Acciaccatura);
-            voice.insertPosition(gracePos);
+            positions.push_back(gracePos);
             ++position;
         }
     }
@@ -512,7 +520,7 @@ int GuitarProImporter::convertBeat(const Gp::Beat &beat, System &system,
     pos.setProperty(Position::PalmMuting, hasPalmMutedNote);
     pos.setProperty(Position::LetRing, hasLetRingNote);
 
-    voice.insertPosition(pos);
+    positions.push_back(std::move(pos));
     return position + 1;
 }
 
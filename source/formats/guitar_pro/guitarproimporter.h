@@ -19,6 +19,7 @@
 #define FORMATS_GUITARPROIMPORTER_H
 
 #include <formats/fileformat.h>
+#include <vector>
 
 namespace Gp
 {
@@ -29,6 +30,7 @@ namespace Gp
 }
 
 class KeySignature;
+class Position;
 class ScoreInfo;
 class System;
 class TimeSignature;
@@ -53,8 +55,9 @@ private:
                               TimeSignature &lastTimeSig);
     static void convertAlternateEndings(const Gp::Measure &measure,
                                         System &system, int position);
-    static int convertBeat(const Gp::Beat &beat, System &system, Voice &voice,
-                           int position);
+    /// Converts the beat and appends its position(s) to the list.
+    static int convertBeat(const Gp::Beat &beat, System &system,
+                           std::vector<Position> &positions, int position);
     static void convertIrregularGroupings(const std::vector<Gp::Beat> &beats,
                                           const std::vector<int> &positions,
                                           Voice &voice);
@@ -20,9 +20,9 @@
 
 #include <bitset>
 #include <cstdint>
-#include <istream>
 #include <vector>
 
+#include <formats/bytereader.h>
 #include "document.h"
 
 namespace Gp
@@ -33,7 +33,7 @@ typedef std::bitset<8> Flags;
 class InputStream
 {
 public:
-    InputStream(std::istream &stream);
+    InputStream(const ByteReader &reader);
 
     /// Reads simple data (e.g. uint32_t, int16_t) from the input stream.
     template <class T>
@@ -70,16 +70,14 @@ private:
     template <class LengthPrefixType>
     std::string readCharacterString();
 
-    std::istream &myStream;
+    ByteReader myReader;
 };
 
 template <class T>
 inline T InputStream::read()
 {
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
-    T data;
-    myStream.read((char *)&data, sizeof(data));
-    return data;
+    return myReader.read<T>();
 }
 
 template <typename LengthPrefixType>
@@ -89,14 +87,7 @@ inline std::string InputStream::readCharacterString()
                   "LengthPrefixType must be an integral type");
 
     const LengthPrefixType length = read<LengthPrefixType>();
-
-    std::string str;
-    str.resize(length);
-
-    if (length != 0)
-        myStream.read(&str[0], length);
-
-    return str;
+    return myReader.readString(length);
 }
 }
 
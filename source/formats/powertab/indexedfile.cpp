@@ -0,0 +1,241 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "indexedfile.h"
+
+#include <algorithm>
+#include <boost/crc.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <cstdint>
+#include <formats/bytereader.h>
+#include <formats/fileformat.h>
+#include <ostream>
+#include <score/score.h>
+#include <score/serialization.h>
+#include <score/systemloader.h>
+#include <vector>
+
+namespace
+{
+const char theMagic[] = { 'P', 'T', 'I', 'X' };
+/// Version 2 added a checksum for each block.
+const uint32_t theContainerVersion = 2;
+
+/// The location of a compressed block within the file.
+struct Block
+{
+    uint32_t myOffset;
+    uint32_t mySize;
+    /// The CRC-32 of the compressed data, if the file has checksums.
+    uint32_t myChecksum;
+};
+
+/// Serializes a score without its systems.
+class ScoreMetadata
+{
+public:
+    explicit ScoreMetadata(Score &score) : myScore(score)
+    {
+    }
+
+    template <class Archive>
+    void serialize(Archive &ar, const FileVersion version)
+    {
+        myScore.serializeWithoutSystems(ar, version);
+    }
+
+private:
+    Score &myScore;
+};
+
+/// Loads systems from a copy of the file's data.
+class IndexedSystemLoader : public SystemLoader
+{
+public:
+    IndexedSystemLoader(std::string data, std::vector<Block> blocks)
+        : myData(std::move(data)), myBlocks(std::move(blocks))
+    {
+    }
+
+    virtual int getSystemCount() const override
+    {
+        return static_cast<int>(myBlocks.size());
+    }
+
+    virtual void loadSystem(int index, System &system) const override;
+
+private:
+    const std::string myData;
+    const std::vector<Block> myBlocks;
+};
+}
+
+template <typename T>
+static void loadBlock(const char *data, const Block &block,
+                      const std::string &name, T &obj)
+{
+    boost::iostreams::filtering_istream input;
+    input.push(boost::iostreams::gzip_decompressor());
+    input.push(boost::iostreams::array_source(data + block.myOffset,
+                                              block.mySize));
+
+    ScoreUtils::load(input, name, obj);
+}
+
+template <typename T>
+static std::string saveBlock(const std::string &name, const T &obj)
+{
+    std::string data;
+
+    boost::iostreams::filtering_ostream output;
+    output.push(boost::iostreams::gzip_compressor());
+    output.push(boost::iostreams::back_inserter(data));
+
+    ScoreUtils::save(output, name, obj);
+    // Flush the remaining compressed data.
+    output.reset();
+
+    return data;
+}
+
+void IndexedSystemLoader::loadSystem(int index, System &system) const
+{
+    loadBlock(myData.data(), myBlocks.at(index), "system", system);
+}
+
+static uint32_t computeChecksum(const char *data, size_t size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+/// Reads the location of a block and verifies its contents, so that a
+/// corrupt system is reported when the file is opened rather than when the
+/// system is first accessed.
+static Block readBlock(ByteReader &reader, uint32_t version)
+{
+    Block block;
+    block.myOffset = reader.read<uint32_t>();
+    block.mySize = reader.read<uint32_t>();
+    block.myChecksum = (version >= 2) ? reader.read<uint32_t>() : 0;
+
+    if (block.myOffset > reader.size() ||
+        block.mySize > reader.size() - block.myOffset)
+    {
+        throw FileFormatException("Invalid block offset");
+    }
+
+    // Each block must at least have a gzip header.
+    const unsigned char *bytes =
+        reinterpret_cast<const unsigned char *>(reader.data()) +
+        block.myOffset;
+    if (block.mySize < 18 || bytes[0] != 0x1f || bytes[1] != 0x8b)
+        throw FileFormatException("Invalid block");
+
+    if (version >= 2 &&
+        computeChecksum(reader.data() + block.myOffset, block.mySize) !=
+            block.myChecksum)
+    {
+        throw FileFormatException("Corrupt block");
+    }
+
+    return block;
+}
+
+static void writeUInt32(std::ostream &output, uint32_t value)
+{
+    // Always write little-endian values, to match ByteReader.
+    for (int i = 0; i < 4; ++i)
+        output.put(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+namespace IndexedFile
+{
+bool isIndexedFile(const ByteReader &reader)
+{
+    return reader.size() >= sizeof(theMagic) &&
+           std::equal(theMagic, theMagic + sizeof(theMagic), reader.data());
+}
+
+void load(const ByteReader &data, Score &score)
+{
+    ByteReader reader(data);
+    reader.seek(0);
+    reader.skip(sizeof(theMagic));
+
+    const uint32_t version = reader.read<uint32_t>();
+    if (version > theContainerVersion)
+        throw FileFormatException("Unsupported file version");
+
+    const Block metadataBlock = readBlock(reader, version);
+
+    const size_t entrySize = ((version >= 2) ? 3 : 2) * sizeof(uint32_t);
+    const uint32_t systemCount = reader.read<uint32_t>();
+    if (systemCount > reader.remaining() / entrySize)
+        throw FileFormatException("Invalid system count");
+
+    std::vector<Block> systemBlocks(systemCount);
+    for (Block &block : systemBlocks)
+        block = readBlock(reader, version);
+
+    ScoreMetadata metadata(score);
+    loadBlock(reader.data(), metadataBlock, "score", metadata);
+
+    // The systems are loaded from a copy of the data, since the file may be
+    // modified or removed while the score is open.
+    score.setSystemLoader(std::unique_ptr<SystemLoader>(new IndexedSystemLoader(
+        std::string(reader.data(), reader.size()), std::move(systemBlocks))));
+}
+
+void save(std::ostream &output, const Score &score)
+{
+    const std::string metadata =
+        saveBlock("score", ScoreMetadata(const_cast<Score &>(score)));
+
+    std::vector<std::string> systems;
+    for (const System &system : score.getSystems())
+        systems.push_back(saveBlock("system", system));
+
+    // The blocks are stored after the header.
+    size_t offset = sizeof(theMagic) + 5 * sizeof(uint32_t) +
+                    systems.size() * 3 * sizeof(uint32_t);
+
+    auto writeBlock = [&](const std::string &block) {
+        writeUInt32(output, static_cast<uint32_t>(offset));
+        writeUInt32(output, static_cast<uint32_t>(block.size()));
+        writeUInt32(output, computeChecksum(block.data(), block.size()));
+        offset += block.size();
+    };
+
+    output.write(theMagic, sizeof(theMagic));
+    writeUInt32(output, theContainerVersion);
+
+    writeBlock(metadata);
+
+    writeUInt32(output, static_cast<uint32_t>(systems.size()));
+    for (const std::string &system : systems)
+        writeBlock(system);
+
+    output.write(metadata.data(), metadata.size());
+    for (const std::string &system : systems)
+        output.write(system.data(), system.size());
+}
+}
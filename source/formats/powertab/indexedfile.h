@@ -0,0 +1,53 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FORMATS_POWERTAB_INDEXEDFILE_H
+#define FORMATS_POWERTAB_INDEXEDFILE_H
+
+#include <iosfwd>
+
+class ByteReader;
+class Score;
+
+/// An alternative layout for .pt2 files, where the score's metadata and each
+/// of its systems are compressed separately and located through a table of
+/// offsets. This allows the systems to be loaded when they are first accessed
+/// rather than when the file is opened.
+///
+/// The file begins with a header, followed by the data blocks:
+///   char[4]  magic ("PTIX")
+///   uint32   container version
+///   uint32   offset, uint32 size, uint32 CRC-32 of the metadata block
+///   uint32   number of systems
+///   uint32   offset, uint32 size, uint32 CRC-32 of each system's block
+/// Each block is a gzip-compressed JSON document, as in a regular .pt2 file.
+/// Version 1 files do not have the CRC-32 fields.
+namespace IndexedFile
+{
+/// Returns whether the data begins with the header of an indexed file.
+bool isIndexedFile(const ByteReader &reader);
+
+/// Loads the score's metadata, players and instruments, and sets up the
+/// score to load each system when it is first accessed. The checksum of each
+/// block is verified up front, so that a corrupt file is rejected here.
+/// @throws FileFormatException
+void load(const ByteReader &reader, Score &score);
+
+void save(std::ostream &output, const Score &score);
+}
+
+#endif
@@ -18,23 +18,40 @@
 #include "powertabexporter.h"
 
 #include "common.h"
+#include "indexedfile.h"
+#include <app/settingsmanager.h>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <score/score.h>
+#include <formats/settings.h>
 #include <score/serialization.h>
 
-PowerTabExporter::PowerTabExporter()
-    : FileFormatExporter(getPowerTabFileFormat())
+PowerTabExporter::PowerTabExporter(const SettingsManager &settings_manager)
+    : FileFormatExporter(getPowerTabFileFormat()),
+      mySettingsManager(settings_manager)
 {
 }
 
 void PowerTabExporter::save(const boost::filesystem::path &filename,
                             const Score &score)
 {
-    // Use gzip to compress the resulting data.
+    bool indexed = false;
+    {
+        auto settings = mySettingsManager.getReadHandle();
+        indexed = settings->get(Settings::IndexedPowerTabFiles);
+    }
+
     boost::filesystem::ofstream file(filename,
                                      std::ios::out | std::ios::binary);
+
+    if (indexed)
+    {
+        IndexedFile::save(file, score);
+        return;
+    }
+
+    // Use gzip to compress the resulting data.
     boost::iostreams::filtering_ostreambuf out;
     out.push(boost::iostreams::gzip_compressor());
     out.push(file);
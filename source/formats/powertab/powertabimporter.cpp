@@ -18,10 +18,13 @@
 #include "powertabimporter.h"
 
 #include "common.h"
+#include "indexedfile.h"
 
-#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
+#include <formats/bytereader.h>
 #include <score/score.h>
 #include <score/serialization.h>
 
@@ -33,12 +36,20 @@ PowerTabImporter::PowerTabImporter()
 void PowerTabImporter::load(const boost::filesystem::path &filename,
                             Score &score)
 {
+    const boost::iostreams::mapped_file_source file = mapFile(filename);
+    const ByteReader reader(file.data(), file.size());
+
+    if (IndexedFile::isIndexedFile(reader))
+    {
+        IndexedFile::load(reader, score);
+        return;
+    }
+
     // The files are compressed by gzip, so we need to uncompress them before
     // loading the data.
-    boost::filesystem::ifstream file(filename, std::ios::in | std::ios::binary);
     boost::iostreams::filtering_istreambuf in;
     in.push(boost::iostreams::gzip_decompressor());
-    in.push(file);
+    in.push(boost::iostreams::array_source(file.data(), file.size()));
 
     std::istream compressed_input(&in);
     ScoreUtils::load(compressed_input, "score", score);
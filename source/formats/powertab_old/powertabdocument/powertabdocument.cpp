@@ -215,20 +215,20 @@ bool Document::Save(const PathType& fileName) const
 }
 
 /// Loads a power tab file.
-/// @param fileName Full path of the file to load.
-/// @throw std::ifstream::failure
-void Document::Load(const boost::filesystem::path& fileName)
+/// @param reader Contents of the file.
+/// @param fileName Full path of the file that was loaded.
+/// @throw FileFormatException
+void Document::Load(const ByteReader& reader,
+                    const boost::filesystem::path& fileName)
 {
-    boost::filesystem::ifstream fileStream(fileName, std::ifstream::in |
-                                                         std::ifstream::binary);
-    PowerTabInputStream stream(fileStream);
+    PowerTabInputStream stream(reader);
 
     DeleteContents();
 
     // read the header
     if (!m_header.Deserialize(stream))
     {
-        throw std::runtime_error("Invalid header");
+        throw FileFormatException("Invalid header");
     }
 
     // read the rest of the document
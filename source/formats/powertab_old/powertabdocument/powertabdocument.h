@@ -19,6 +19,8 @@
 #include <boost/filesystem/path.hpp>
 #include <vector>
 
+class ByteReader;
+
 namespace PowerTabDocument {
 
 class Guitar;
@@ -66,7 +68,7 @@ public:
     ~Document();
 
     bool Save(const PathType& fileName) const;
-    void Load(const PathType& fileName);
+    void Load(const ByteReader& reader, const PathType& fileName);
 
     bool Deserialize(PowerTabInputStream& stream);
 
@@ -18,11 +18,9 @@ namespace PowerTabDocument {
 
 using std::string;
 
-PowerTabInputStream::PowerTabInputStream(std::istream& stream) :
-    m_stream(stream)
+PowerTabInputStream::PowerTabInputStream(const ByteReader& reader) :
+    m_reader(reader)
 {
-    // ensure that the stream will throw std::ifstream::failure if any errors occur
-    stream.exceptions(std::istream::failbit | std::istream::badbit | std::istream::eofbit);
 }
 
 // Read Functions
@@ -54,12 +52,7 @@ void PowerTabInputStream::ReadMFCString(string& str)
     str.clear();
 
     const uint32_t length = ReadMFCStringLength();
-    str.resize(length);
-
-	if (length != 0)
-	{
-		m_stream.read(&str[0], length);
-	}
+    str = m_reader.readString(length);
 }
 
 /// Reads a Win32 format COLORREF type from the stream
@@ -129,7 +122,7 @@ void PowerTabInputStream::ReadClassInformation()
 
         *this >> schema;
         *this >> length;
-        m_stream.seekg(length, std::ios_base::cur);
+        m_reader.skip(length);
     }
 
     // otherwise, existing class index in obj_tag followed by new object
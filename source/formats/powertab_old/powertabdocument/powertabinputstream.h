@@ -14,7 +14,8 @@
 
 #include <array>
 #include <cstdint>
-#include <istream>
+#include <formats/bytereader.h>
+#include <formats/fileformat.h>
 #include <memory>
 #include <vector>
 
@@ -28,10 +29,10 @@ class PowerTabInputStream
 {
     // Member Variables
 private:
-    std::istream& m_stream;
+    ByteReader m_reader;
 
 public:
-    PowerTabInputStream(std::istream& stream);
+    PowerTabInputStream(const ByteReader& reader);
 
     // Read Functions
     uint32_t ReadCount();
@@ -61,11 +62,11 @@ public:
     }
 
     /// Read data from the input stream
-    /// @throw std::ifstream::failure if any errors occur
+    /// @throw FileFormatException if any errors occur
     template<class T>
     inline PowerTabInputStream& operator>>(T& data)
     {
-        m_stream.read(reinterpret_cast<char *>(&data), sizeof(data));
+        data = m_reader.read<T>();
         return *this;
     }
 
@@ -76,9 +77,10 @@ public:
         *this >> size;
 
         vect.clear();
-        vect.resize(size);
+        vect.reserve(size);
 
-        m_stream.read((char*)&vect[0], size * sizeof(T));
+        for (uint8_t i = 0; i < size; ++i)
+            vect.push_back(m_reader.read<T>());
     }
 
     template <class T, size_t N>
@@ -87,7 +89,11 @@ public:
         uint8_t size = 0;
         *this >> size;
 
-        m_stream.read((char*)&array[0], size * sizeof(T));
+        if (size > N)
+            throw FileFormatException("Invalid array size");
+
+        for (uint8_t i = 0; i < size; ++i)
+            array[i] = m_reader.read<T>();
     }
 
 private:
@@ -17,6 +17,8 @@
 
 #include "powertaboldimporter.h"
 
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <formats/bytereader.h>
 #include <formats/powertab_old/powertabdocument/alternateending.h>
 #include <formats/powertab_old/powertabdocument/barline.h>
 #include <formats/powertab_old/powertabdocument/chordtext.h>
@@ -46,8 +48,13 @@ PowerTabOldImporter::PowerTabOldImporter()
 void PowerTabOldImporter::load(const boost::filesystem::path &filename,
                                Score &score)
 {
+    resetPhaseTimings();
+
+    const boost::iostreams::mapped_file_source file = mapFile(filename);
+
     PowerTabDocument::Document document;
-    document.Load(filename);
+    document.Load(ByteReader(file.data(), file.size()), filename);
+    endPhase("read");
 
     // TODO - handle font settings, etc.
     ScoreInfo info;
@@ -57,19 +64,62 @@ void PowerTabOldImporter::load(const boost::filesystem::path &filename,
     ScoreUtils::addStandardFilters(score);
     
     assert(document.GetNumberOfScores() == 2);
+    const PowerTabDocument::Score &oldGuitarScore = *document.GetScore(0);
+    const PowerTabDocument::Score &oldBassScore = *document.GetScore(1);
+
+    if (!hasNotes(oldBassScore))
+    {
+        // If there is nothing to merge in from the bass score, the guitar
+        // score can be converted directly and its layout is already final.
+        convert(oldGuitarScore, score);
+
+        // Keep the bass score's players, as the merge would have done.
+        for (size_t i = 0; i < oldBassScore.GetGuitarCount(); ++i)
+            convert(*oldBassScore.GetGuitar(i), score);
+
+        endPhase("convert");
+        return;
+    }
 
     // Convert the guitar score.
     Score guitarScore;
-    convert(*document.GetScore(0), guitarScore);
+    convert(oldGuitarScore, guitarScore);
 
     // Convert and then merge the bass score.
     Score bassScore;
-    convert(*document.GetScore(1), bassScore);
+    convert(oldBassScore, bassScore);
+    endPhase("convert");
+
     ScoreMerger::merge(score, guitarScore, bassScore);
+    endPhase("merge");
 
     // Reformat the score, since the guitar and bass score from v1.7 may have
     // had different spacing.
-    ScoreUtils::polishScore(score);
+    ScoreUtils::polishScore(
+        score, ScoreUtils::ParallelOptions(getNumThreads()));
+    endPhase("polish");
+}
+
+bool PowerTabOldImporter::hasNotes(const PowerTabDocument::Score &oldScore)
+{
+    for (size_t i = 0; i < oldScore.GetSystemCount(); ++i)
+    {
+        auto oldSystem = oldScore.GetSystem(i);
+
+        for (size_t j = 0; j < oldSystem->GetStaffCount(); ++j)
+        {
+            auto oldStaff = oldSystem->GetStaff(j);
+
+            for (size_t voice = 0;
+                 voice < PowerTabDocument::Staff::NUM_STAFF_VOICES; ++voice)
+            {
+                if (oldStaff->GetPositionCount(voice) > 0)
+                    return true;
+            }
+        }
+    }
+
+    return false;
 }
 
 void PowerTabOldImporter::convert(
@@ -585,20 +635,22 @@ int PowerTabOldImporter::convert(
     for (size_t voice = 0; voice < PowerTabDocument::Staff::NUM_STAFF_VOICES;
          ++voice)
     {
-        for (size_t i = 0; i < oldStaff.GetPositionCount(voice); ++i)
+        std::vector<Position> positions(oldStaff.GetPositionCount(voice));
+        for (size_t i = 0; i < positions.size(); ++i)
         {
-            Position position;
+            Position &position = positions[i];
             convert(*oldStaff.GetPosition(voice, i), position);
-            staff.getVoices()[voice].insertPosition(position);
             lastPosition = std::max(position.getPosition(), lastPosition);
         }
+
+        staff.getVoices()[voice].insertPositions(std::move(positions));
     }
 
     // Import irregular groups.
     for (size_t voice = 0; voice < PowerTabDocument::Staff::NUM_STAFF_VOICES;
          ++voice)
     {
-        Voice &v = staff.getVoices()[voice];
+        std::vector<IrregularGrouping> groups;
         int startPos = 0;
         int positionCount = 0;
         uint8_t notesPlayed = 0;
@@ -618,8 +670,8 @@ int PowerTabOldImporter::convert(
             else if (position.IsIrregularGroupingEnd())
             {
                 positionCount++;
-                v.insertIrregularGrouping(IrregularGrouping(
-                    startPos, positionCount, notesPlayed, notesPlayedOver));
+                groups.emplace_back(startPos, positionCount, notesPlayed,
+                                    notesPlayedOver);
 
                 startPos = 0;
                 positionCount = 0;
@@ -631,6 +683,8 @@ int PowerTabOldImporter::convert(
             else if (position.IsAcciaccatura())
                 positionCount++;
         }
+
+        staff.getVoices()[voice].insertIrregularGroupings(std::move(groups));
     }
 
     return lastPosition;
@@ -115,6 +115,9 @@ private:
                                     Score &score);
 
     static void merge(Score &score1, Score &score2);
+
+    /// Returns whether any staff in the score contains notes or rests.
+    static bool hasNotes(const PowerTabDocument::Score &oldScore);
 };
 
 #endif
@@ -17,7 +17,7 @@
   
 #include "midifile.h"
 
-#include "repeatcontroller.h"
+#include "performanceorder.h"
 
 #include <boost/rational.hpp>
 
@@ -25,7 +25,9 @@
 #include <score/score.h>
 #include <score/scorelocation.h>
 #include <score/systemlocation.h>
+#include <score/ticks.h>
 #include <score/utils.h>
+#include <score/utils/scoreview.h>
 #include <score/voiceutils.h>
 
 static const int PERCUSSION_CHANNEL = 9;
@@ -68,73 +70,20 @@ static int getChannel(const ActivePlayer &player)
     return getChannel(player.getPlayerNumber());
 }
 
-static bool findPositionChange(MidiEventList &event_list, int ticks,
-                               bool record_position_changes,
-                               RepeatController &repeat_controller,
-                               const SystemLocation &prev_location,
-                               SystemLocation &location)
-{
-    SystemLocation new_location;
-    if (repeat_controller.checkForRepeat(prev_location, location, new_location))
-    {
-        if (record_position_changes)
-        {
-            event_list.append(MidiEvent::positionChange(ticks, new_location));
-        }
-
-        location = new_location;
-        return true;
-    }
-
-    return false;
-}
-
-static SystemLocation moveToNextBar(MidiEventList &event_list, int ticks,
-                                    bool record_position_changes,
-                                    const System &system,
-                                    SystemLocation location, int next_bar_pos,
-                                    RepeatController &repeat_controller)
+MidiFile::MidiFile() : myTicksPerBeat(0)
 {
-    SystemLocation prev_location = location;
-    SystemLocation new_location;
-
-    // Move to the next barline and follow any directions / repeats / alternate
-    // endings.
-    location.setPosition(next_bar_pos);
-
-    if (findPositionChange(event_list, ticks, record_position_changes,
-                           repeat_controller, prev_location, location))
-    {
-        return location;
-    }
-
-    // If we're at the end of the system, shift to the next system and also
-    // check for a position change there.
-    if (next_bar_pos == system.getBarlines().back().getPosition())
-    {
-        location.setSystem(location.getSystem() + 1);
-        location.setPosition(0);
-
-        if (findPositionChange(event_list, ticks, record_position_changes,
-                               repeat_controller, prev_location, location))
-        {
-            return location;
-        }
-    }
-
-    return location;
 }
 
-MidiFile::MidiFile() : myTicksPerBeat(0)
+void MidiFile::load(const Score &score, const LoadOptions &options)
 {
+    load(score, PerformanceOrder(score), options);
 }
 
-void MidiFile::load(const Score &score, const LoadOptions &options)
+void MidiFile::load(const Score &score, const PerformanceOrder &order,
+                    const LoadOptions &options)
 {
     myTicksPerBeat = DEFAULT_PPQ;
 
-    RepeatController repeat_controller(score);
-
     MidiEventList master_track;
     MidiEventList metronome_track;
 
@@ -153,18 +102,31 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
 
     }
 
-    SystemLocation location(0, 0);
+    // Flatten the score's positions and compute their durations up front, since
+    // bars may be played more than once.
+    const ScoreView view(score);
+
     std::vector<uint8_t> active_bends;
     int system_index = -1;
     int current_tick = 0;
     int current_tempo = Midi::BEAT_DURATION_120_BPM;
 
-    while (location.getSystem() < score.getSystems().size())
+    for (const PerformanceOrder::Bar &bar : order.getBars())
     {
+        const SystemLocation &location = bar.myLocation;
         const System &system = score.getSystems()[location.getSystem()];
         const Barline *current_bar = ScoreUtils::findByPosition(
             system.getBarlines(), location.getPosition());
-        const Barline *next_bar = system.getNextBarline(location.getPosition());
+        const Barline *next_bar = ScoreUtils::findByPosition(
+            system.getBarlines(), bar.myEndPosition);
+
+        myBarStartTicks.push_back(current_tick);
+
+        if (bar.myIsJump && options.myRecordPositionChanges)
+        {
+            metronome_track.append(
+                MidiEvent::positionChange(current_tick, location));
+        }
 
         if (location.getSystem() != system_index)
         {
@@ -187,7 +149,8 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
             {
                 const int end_tick = addEventsForBar(
                     regular_tracks, active_bends[staff_index], start_tick,
-                    current_tempo, score, system, location.getSystem(), staff,
+                    current_tempo, score, view, system, location.getSystem(),
+                    staff,
                     staff_index, staff.getVoices()[voice_index], voice_index,
                     current_bar->getPosition(), next_bar->getPosition(),
                     options);
@@ -201,10 +164,6 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
             current_tick,
             generateMetronome(metronome_track, start_tick, system, *current_bar,
                               *next_bar, location, options));
-
-        location = moveToNextBar(
-            metronome_track, current_tick, options.myRecordPositionChanges,
-            system, location, next_bar->getPosition(), repeat_controller);
     }
 
     myTracks.push_back(master_track);
@@ -233,9 +192,8 @@ int MidiFile::generateMetronome(MidiEventList &event_list, int current_tick,
     const int beat_value = time_sig.getBeatValue();
 
     // Figure out the duration of a pulse.
-    const int duration = boost::rational_cast<int>(
-        boost::rational<int>(4, beat_value) *
-        boost::rational<int>(beats_per_measure, num_pulses) * myTicksPerBeat);
+    const int duration =
+        4 * beats_per_measure * myTicksPerBeat / (beat_value * num_pulses);
 
     // Check for multi-bar rests, as we need to generate more metronome events
     // to fill the extra bars.
@@ -306,20 +264,14 @@ int MidiFile::addTempoEvent(MidiEventList &event_list, int current_tick,
     return current_tempo;
 }
 
-static int getWholeRestDuration(const System &system, const Voice &voice,
-                                const Position &pos, int bar_start, int bar_end,
-                                int original_duration)
+static int getWholeRestDuration(const System &system,
+                                const ScoreView::IndexRange &bar_positions,
+                                int bar_start, int original_duration)
 {
     // If the whole rest is not the only item in the bar, treat it like a
     // regular rest.
-    for (int i = bar_start; i < bar_end; ++i)
-    {
-        const Position *other_pos =
-            ScoreUtils::findByPosition(voice.getPositions(), i);
-
-        if (other_pos && other_pos != &pos)
-            return original_duration;
-    }
+    if (bar_positions.second - bar_positions.first != 1)
+        return original_duration;
 
     // Otherwise, extend the rest for the entire bar.
     const Barline *barline =
@@ -379,16 +331,14 @@ static Velocity getNoteVelocity(const Position &pos, const Note &note)
 /// a 32nd note at 120bpm.
 static int getGraceNoteTicks(int ppq, int current_tempo)
 {
-    return boost::rational_cast<int>(
-        boost::rational<int>(Midi::BEAT_DURATION_120_BPM, 8) /
-        boost::rational<int>(current_tempo, ppq));
+    return static_cast<int>(static_cast<int64_t>(Midi::BEAT_DURATION_120_BPM) *
+                            ppq / (8 * static_cast<int64_t>(current_tempo)));
 }
 
 static int getArpeggioOffset(int ppq, int current_tempo)
 {
-    return boost::rational_cast<int>(
-        boost::rational<int>(Midi::BEAT_DURATION_120_BPM, 16) /
-        boost::rational<int>(current_tempo, ppq));
+    return static_cast<int>(static_cast<int64_t>(Midi::BEAT_DURATION_120_BPM) *
+                            ppq / (16 * static_cast<int64_t>(current_tempo)));
 }
 
 /// Holds basic information about a bend - used to simplify the generateBends
@@ -570,15 +520,21 @@ static void generateSlides(std::vector<BendEventInfo> &bends, int start_tick,
 
 int MidiFile::addEventsForBar(
     std::vector<MidiEventList> &tracks, uint8_t &active_bend, int current_tick,
-    int current_tempo, const Score &score, const System &system,
-    int system_index, const Staff &staff, int staff_index, const Voice &voice,
-    int voice_index, int bar_start, int bar_end, const LoadOptions &options)
+    int current_tempo, const Score &score, const ScoreView &view,
+    const System &system, int system_index, const Staff &staff,
+    int staff_index, const Voice &voice, int voice_index, int bar_start,
+    int bar_end, const LoadOptions &options)
 {
     ScoreLocation location(score, system_index, staff_index, voice_index);
     const Voice *prev_voice = VoiceUtils::getAdjacentVoice(location, -1);
     const Voice *next_voice = VoiceUtils::getAdjacentVoice(location, 1);
     bool let_ring_active = false;
 
+    const ScoreView::IndexRange bar_positions = view.findPositionsInRange(
+        view.getVoiceIndex(system_index, staff_index, voice_index), bar_start,
+        bar_end);
+    int next_pos_index = bar_positions.first;
+
     for (int position = bar_start; position < bar_end; ++position)
     {
         // Handle player/instrument changes.
@@ -620,14 +576,18 @@ int MidiFile::addEventsForBar(
         }
 
         // Handle notes.
-        const Position *pos =
-            ScoreUtils::findByPosition(voice.getPositions(), position);
-        if (!pos)
+        if (next_pos_index == bar_positions.second ||
+            view.getPositionLocation(next_pos_index) != position)
+        {
             continue;
+        }
+
+        const int pos_index = next_pos_index++;
+        const Position *pos = &view.getPosition(pos_index);
 
         const SystemLocation system_location(system_index, position);
-        int duration = boost::rational_cast<int>(
-            myTicksPerBeat * VoiceUtils::getDurationTime(voice, *pos));
+        int duration = static_cast<int>(
+            Ticks::convert(view.getDuration(pos_index), myTicksPerBeat));
 
         if (pos->isRest())
         {
@@ -635,8 +595,8 @@ int MidiFile::addEventsForBar(
             // of time signature.
             if (pos->getDurationType() == Position::WholeNote)
             {
-                duration = getWholeRestDuration(system, voice, *pos, bar_start,
-                                                bar_end, duration);
+                duration = getWholeRestDuration(system, bar_positions,
+                                                bar_start, duration);
 
                 // Extend for multi-bar rests.
                 if (pos->hasMultiBarRest())
@@ -705,10 +665,7 @@ int MidiFile::addEventsForBar(
             let_ring_active = false;
         }
         // Make sure that we end the let ring after the last position in the bar.
-        else if (let_ring_active &&
-                 (pos ==
-                  &ScoreUtils::findInRange(voice.getPositions(), bar_start,
-                                           bar_end) .back()))
+        else if (let_ring_active && pos_index == bar_positions.second - 1)
         {
             for (const ActivePlayer &player : active_players)
             {
@@ -879,15 +836,13 @@ int MidiFile::addEventsForBar(
             if (!tied_to_next_note)
             {
                 // Shorten the note duration for certain effects.
-                boost::rational<int> factor(1);
+                int note_length = duration;
                 if (pos->hasProperty(Position::Staccato))
-                    factor /= 2;
+                    note_length /= 2;
                 else if (pos->hasProperty(Position::PalmMuting))
-                    factor /= boost::rational<int>(23, 20);
+                    note_length = note_length * 20 / 23;
                 else if (note.hasProperty(Note::Muted))
-                    factor /= 8;
-
-                int note_length = boost::rational_cast<int>(duration * factor);
+                    note_length /= 8;
 
                 for (const ActivePlayer &player : active_players)
                 {
@@ -24,7 +24,9 @@
 #include <vector>
 
 class Barline;
+class PerformanceOrder;
 class Score;
+class ScoreView;
 class Staff;
 class System;
 class SystemLocation;
@@ -58,10 +60,16 @@ public:
     MidiFile();
 
     void load(const Score &score, const LoadOptions &options);
+    /// Generates the MIDI events using a precomputed performance order, which
+    /// must be up to date with the score.
+    void load(const Score &score, const PerformanceOrder &order,
+              const LoadOptions &options);
 
     int getTicksPerBeat() const { return myTicksPerBeat; }
     std::vector<MidiEventList> &getTracks() { return myTracks; }
     const std::vector<MidiEventList> &getTracks() const { return myTracks; }
+    /// Returns the tick at which each bar of the performance order starts.
+    const std::vector<int> &getBarStartTicks() const { return myBarStartTicks; }
 
 private:
     int generateMetronome(MidiEventList &event_list, int current_tick,
@@ -77,13 +85,15 @@ private:
     int addEventsForBar(std::vector<MidiEventList> &tracks,
                         uint8_t &active_bend, int current_tick,
                         int current_tempo, const Score &score,
-                        const System &system, int system_index,
+                        const ScoreView &view, const System &system,
+                        int system_index,
                         const Staff &staff, int staff_index, const Voice &voice,
                         int voice_index, int bar_start, int bar_end,
                         const LoadOptions &options);
 
     int myTicksPerBeat;
     std::vector<MidiEventList> myTracks;
+    std::vector<int> myBarStartTicks;
 };
 
 #endif
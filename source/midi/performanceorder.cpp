@@ -0,0 +1,146 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "performanceorder.h"
+
+#include <algorithm>
+#include <limits>
+#include <midi/repeatcontroller.h>
+#include <score/score.h>
+#include <score/utils.h>
+
+PerformanceOrder::Bar::Bar(const SystemLocation &location, int endPosition,
+                           int repeatNumber, bool isJump)
+    : myLocation(location),
+      myEndPosition(endPosition),
+      myRepeatNumber(repeatNumber),
+      myIsJump(isJump)
+{
+}
+
+static bool findPositionChange(RepeatController &repeat_controller,
+                               const SystemLocation &prev_location,
+                               SystemLocation &location)
+{
+    SystemLocation new_location;
+    if (repeat_controller.checkForRepeat(prev_location, location, new_location))
+    {
+        location = new_location;
+        return true;
+    }
+
+    return false;
+}
+
+/// Moves to the next barline and follows any directions / repeats / alternate
+/// endings. Returns true if a position change occurred.
+static bool moveToNextBar(const System &system, SystemLocation &location,
+                          int next_bar_pos, RepeatController &repeat_controller)
+{
+    const SystemLocation prev_location = location;
+    location.setPosition(next_bar_pos);
+
+    if (findPositionChange(repeat_controller, prev_location, location))
+        return true;
+
+    // If we're at the end of the system, shift to the next system and also
+    // check for a position change there.
+    if (next_bar_pos == system.getBarlines().back().getPosition())
+    {
+        location.setSystem(location.getSystem() + 1);
+        location.setPosition(0);
+
+        return findPositionChange(repeat_controller, prev_location, location);
+    }
+
+    return false;
+}
+
+PerformanceOrder::PerformanceOrder(const Score &score)
+{
+    RepeatController repeat_controller(score);
+    SystemLocation location(0, 0);
+    bool is_jump = false;
+
+    while (location.getSystem() < static_cast<int>(score.getSystems().size()))
+    {
+        const System &system = score.getSystems()[location.getSystem()];
+        const Barline *current_bar = ScoreUtils::findByPosition(
+            system.getBarlines(), location.getPosition());
+        const Barline *next_bar = system.getNextBarline(location.getPosition());
+
+        myBars.emplace_back(
+            SystemLocation(location.getSystem(), current_bar->getPosition()),
+            next_bar->getPosition(),
+            repeat_controller.getActiveRepeatNumber(location), is_jump);
+
+        is_jump = moveToNextBar(system, location, next_bar->getPosition(),
+                                repeat_controller);
+    }
+
+    myBarIndex.reserve(myBars.size());
+    for (int i = 0; i < static_cast<int>(myBars.size()); ++i)
+        myBarIndex.emplace_back(myBars[i].myLocation, i);
+
+    std::sort(myBarIndex.begin(), myBarIndex.end());
+}
+
+std::pair<PerformanceOrder::BarIndex::const_iterator,
+          PerformanceOrder::BarIndex::const_iterator>
+PerformanceOrder::findBar(const SystemLocation &location) const
+{
+    // Find the last bar that starts at or before the location.
+    auto it = std::upper_bound(
+        myBarIndex.begin(), myBarIndex.end(),
+        std::make_pair(location, std::numeric_limits<int>::max()));
+
+    if (it == myBarIndex.begin())
+        return std::make_pair(myBarIndex.end(), myBarIndex.end());
+
+    const SystemLocation &bar_start = std::prev(it)->first;
+    const Bar &bar = myBars[std::prev(it)->second];
+
+    // The location might be in a bar that is never played (e.g. skipped by a
+    // coda), rather than the bar that was found.
+    if (bar_start.getSystem() != location.getSystem() ||
+        location.getPosition() > bar.myEndPosition)
+    {
+        return std::make_pair(myBarIndex.end(), myBarIndex.end());
+    }
+
+    auto first = std::lower_bound(myBarIndex.begin(), it,
+                                  std::make_pair(bar_start, 0));
+    return std::make_pair(first, it);
+}
+
+std::vector<int> PerformanceOrder::findBarIndices(
+    const SystemLocation &location) const
+{
+    std::vector<int> indices;
+
+    auto range = findBar(location);
+    for (auto it = range.first; it != range.second; ++it)
+        indices.push_back(it->second);
+
+    return indices;
+}
+
+int PerformanceOrder::findFirstBarIndex(const SystemLocation &location) const
+{
+    auto range = findBar(location);
+    return range.first != range.second ? range.first->second : -1;
+}
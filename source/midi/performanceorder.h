@@ -0,0 +1,80 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef MIDI_PERFORMANCEORDER_H
+#define MIDI_PERFORMANCEORDER_H
+
+#include <score/systemlocation.h>
+#include <utility>
+#include <vector>
+
+class Score;
+
+/// The order in which the bars of a score are played, after following all of
+/// the repeats, alternate endings, and musical directions. This is computed
+/// once for a score, and can then be shared by e.g. MIDI generation and
+/// playback without replaying the repeats each time.
+class PerformanceOrder
+{
+public:
+    /// A bar that is played during the performance.
+    struct Bar
+    {
+        Bar(const SystemLocation &location, int endPosition, int repeatNumber,
+            bool isJump);
+
+        /// The location of the bar's starting barline.
+        SystemLocation myLocation;
+        /// The position of the bar's ending barline.
+        int myEndPosition;
+        /// The number of the current pass through the surrounding repeated
+        /// section, or 1 if the bar is not repeated.
+        int myRepeatNumber;
+        /// Whether playback jumped to this bar from somewhere other than the
+        /// previous bar (due to a repeat or musical direction).
+        bool myIsJump;
+    };
+
+    explicit PerformanceOrder(const Score &score);
+
+    /// Returns the bars in the order that they are played.
+    const std::vector<Bar> &getBars() const { return myBars; }
+
+    /// Returns the indices of each time that the bar containing the location
+    /// is played, in increasing order. This takes O(log n) time, plus the
+    /// number of results.
+    std::vector<int> findBarIndices(const SystemLocation &location) const;
+
+    /// Returns the index of the first time that the bar containing the
+    /// location is played, or -1 if the bar is never played.
+    int findFirstBarIndex(const SystemLocation &location) const;
+
+private:
+    typedef std::vector<std::pair<SystemLocation, int>> BarIndex;
+
+    /// Returns the range of entries in myBarIndex for the bar containing the
+    /// location.
+    std::pair<BarIndex::const_iterator, BarIndex::const_iterator>
+    findBar(const SystemLocation &location) const;
+
+    std::vector<Bar> myBars;
+    /// The location of each bar's start, paired with its index in myBars,
+    /// sorted by location and then by index.
+    BarIndex myBarIndex;
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "playbacktimeline.h"
+
+#include <algorithm>
+#include <limits>
+#include <midi/midifile.h>
+#include <midi/performanceorder.h>
+#include <score/generalmidi.h>
+
+PlaybackTimeline::TempoChange::TempoChange(int tick, int64_t time,
+                                           int beatDuration)
+    : myTick(tick), myTime(time), myBeatDuration(beatDuration)
+{
+}
+
+PlaybackTimeline::PlaybackTimeline(const PerformanceOrder &order,
+                                   const MidiFile &file)
+    : myTicksPerBeat(file.getTicksPerBeat()),
+      myEndTick(0),
+      myBarStartTicks(file.getBarStartTicks())
+{
+    std::vector<std::pair<int, int>> tempos;
+
+    for (MidiEventList track : file.getTracks())
+    {
+        track.convertToAbsoluteTicks();
+
+        for (const MidiEvent &event : track)
+        {
+            myEndTick = std::max(myEndTick, event.getTicks());
+
+            if (event.isTempoChange())
+                tempos.emplace_back(event.getTicks(), event.getTempo());
+            else if ((event.getStatusByte() & 0xf0) == MidiEvent::NoteOn)
+                myLocations.emplace_back(event.getTicks(), event.getLocation());
+        }
+    }
+
+    // Build the tempo map, and compute the time of each tempo change.
+    std::stable_sort(tempos.begin(), tempos.end(),
+                     [](const std::pair<int, int> &a,
+                        const std::pair<int, int> &b) {
+                         return a.first < b.first;
+                     });
+
+    myTempoChanges.emplace_back(0, 0, Midi::BEAT_DURATION_120_BPM);
+    for (const std::pair<int, int> &tempo : tempos)
+    {
+        const int64_t time = getTime(tempo.first);
+
+        // Only the last tempo change at a tick is in effect.
+        if (myTempoChanges.back().myTick == tempo.first)
+            myTempoChanges.back().myBeatDuration = tempo.second;
+        else
+            myTempoChanges.emplace_back(tempo.first, time, tempo.second);
+    }
+
+    // Bars that don't contain any notes still need a location.
+    const std::vector<PerformanceOrder::Bar> &bars = order.getBars();
+    for (size_t i = 0; i < bars.size() && i < myBarStartTicks.size(); ++i)
+        myLocations.emplace_back(myBarStartTicks[i], bars[i].myLocation);
+
+    std::stable_sort(myLocations.begin(), myLocations.end(),
+                     [](const std::pair<int, SystemLocation> &a,
+                        const std::pair<int, SystemLocation> &b) {
+                         return a.first < b.first;
+                     });
+}
+
+int64_t PlaybackTimeline::getDuration() const
+{
+    return getTime(myEndTick);
+}
+
+const PlaybackTimeline::TempoChange &PlaybackTimeline::findTempoAtTick(
+    int tick) const
+{
+    auto it = std::upper_bound(
+        myTempoChanges.begin(), myTempoChanges.end(), tick,
+        [](int t, const TempoChange &tempo) { return t < tempo.myTick; });
+
+    return it == myTempoChanges.begin() ? myTempoChanges.front()
+                                        : *std::prev(it);
+}
+
+int64_t PlaybackTimeline::getTime(int tick) const
+{
+    const TempoChange &tempo = findTempoAtTick(tick);
+    return tempo.myTime + static_cast<int64_t>(tick - tempo.myTick) *
+                              tempo.myBeatDuration / myTicksPerBeat;
+}
+
+int PlaybackTimeline::getTick(int64_t time) const
+{
+    if (time <= 0)
+        return 0;
+
+    auto it = std::upper_bound(myTempoChanges.begin(), myTempoChanges.end(),
+                               time, [](int64_t t, const TempoChange &tempo) {
+                                   return t < tempo.myTime;
+                               });
+    const TempoChange &tempo = *std::prev(it);
+
+    // Round up and then correct for the truncation in getTime(), so that
+    // converting a tick to a time and back is lossless.
+    int64_t tick = tempo.myTick + ((time - tempo.myTime) * myTicksPerBeat +
+                                   tempo.myBeatDuration - 1) /
+                                      tempo.myBeatDuration;
+    tick = std::min<int64_t>(tick, std::numeric_limits<int>::max());
+    if (getTime(static_cast<int>(tick)) > time)
+        --tick;
+
+    return static_cast<int>(tick);
+}
+
+int64_t PlaybackTimeline::getBarStartTime(int bar_index) const
+{
+    return getTime(myBarStartTicks.at(bar_index));
+}
+
+int PlaybackTimeline::findBarIndex(int64_t time) const
+{
+    if (myBarStartTicks.empty())
+        return -1;
+
+    auto it = std::upper_bound(myBarStartTicks.begin(), myBarStartTicks.end(),
+                               getTick(time));
+    if (it == myBarStartTicks.begin())
+        return 0;
+
+    return static_cast<int>(std::prev(it) - myBarStartTicks.begin());
+}
+
+SystemLocation PlaybackTimeline::findLocation(int64_t time) const
+{
+    auto it = std::upper_bound(
+        myLocations.begin(), myLocations.end(), getTick(time),
+        [](int tick, const std::pair<int, SystemLocation> &location) {
+            return tick < location.first;
+        });
+
+    if (it == myLocations.begin())
+        return SystemLocation(0, 0);
+
+    return std::prev(it)->second;
+}
+
+int64_t PlaybackTimeline::findTime(int bar_index,
+                                   const SystemLocation &location) const
+{
+    const int start_tick = myBarStartTicks.at(bar_index);
+    const int end_tick = bar_index + 1 < static_cast<int>(myBarStartTicks.size())
+                             ? myBarStartTicks[bar_index + 1]
+                             : myEndTick + 1;
+
+    auto first = std::lower_bound(
+        myLocations.begin(), myLocations.end(), start_tick,
+        [](const std::pair<int, SystemLocation> &location, int tick) {
+            return location.first < tick;
+        });
+
+    // Within a bar the notes of different staves aren't necessarily sorted by
+    // position, so find the earliest note at or after the location.
+    int tick = end_tick;
+    for (auto it = first; it != myLocations.end() && it->first < end_tick; ++it)
+    {
+        if (it->second.getSystem() == location.getSystem() &&
+            it->second.getPosition() >= location.getPosition())
+        {
+            tick = std::min(tick, it->first);
+        }
+    }
+
+    if (tick == end_tick)
+        tick = std::min(end_tick, myEndTick);
+
+    return getTime(tick);
+}
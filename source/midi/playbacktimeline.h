@@ -0,0 +1,84 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef MIDI_PLAYBACKTIMELINE_H
+#define MIDI_PLAYBACKTIMELINE_H
+
+#include <cstdint>
+#include <score/systemlocation.h>
+#include <utility>
+#include <vector>
+
+class MidiFile;
+class PerformanceOrder;
+
+/// Maps between the elapsed playback time and the location in the score, for
+/// a MIDI file that was generated from a performance order. Times are in
+/// microseconds at normal playback speed, starting from the beginning of the
+/// score. Lookups in either direction are binary searches, so this can be
+/// used for e.g. seeking without replaying the MIDI events.
+class PlaybackTimeline
+{
+public:
+    PlaybackTimeline(const PerformanceOrder &order, const MidiFile &file);
+
+    /// Returns the total length of the performance.
+    int64_t getDuration() const;
+
+    /// Converts a MIDI tick to a time, using the tempo changes in the file.
+    int64_t getTime(int tick) const;
+    /// Converts a time to the last tick that occurs at or before it.
+    int getTick(int64_t time) const;
+
+    /// Returns the time at which a bar of the performance order starts.
+    int64_t getBarStartTime(int bar_index) const;
+    /// Returns the index in the performance order of the bar that is playing
+    /// at the given time, or -1 if the score is empty.
+    int findBarIndex(int64_t time) const;
+
+    /// Returns the location that is being played at the given time.
+    SystemLocation findLocation(int64_t time) const;
+    /// Returns the time at which the location is reached while playing a bar
+    /// of the performance order (e.g. to find the second pass through a
+    /// repeated bar).
+    int64_t findTime(int bar_index, const SystemLocation &location) const;
+
+private:
+    struct TempoChange
+    {
+        TempoChange(int tick, int64_t time, int beatDuration);
+
+        int myTick;
+        int64_t myTime;
+        /// The duration of a beat, in microseconds.
+        int myBeatDuration;
+    };
+
+    /// Returns the last tempo change at or before the tick.
+    const TempoChange &findTempoAtTick(int tick) const;
+
+    int myTicksPerBeat;
+    int myEndTick;
+    /// Sorted by both tick and time. The first entry is always at tick 0.
+    std::vector<TempoChange> myTempoChanges;
+    std::vector<int> myBarStartTicks;
+    /// The locations of the notes that are played, and the start of each bar,
+    /// sorted by tick.
+    std::vector<std::pair<int, SystemLocation>> myLocations;
+};
+
+#endif
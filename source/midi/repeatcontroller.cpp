@@ -48,3 +48,10 @@ bool RepeatController::checkForRepeat(const SystemLocation &prevLocation,
     // Return true if a position shift occurred.
     return newLocation != currentLocation;
 }
+
+int RepeatController::getActiveRepeatNumber(
+    const SystemLocation &location) const
+{
+    const RepeatedSection *repeat = myRepeatIndex.findRepeat(location);
+    return repeat ? repeat->getCurrentRepeatNumber() : 1;
+}
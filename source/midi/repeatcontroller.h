@@ -37,6 +37,10 @@ public:
                         const SystemLocation &currentLocation,
                         SystemLocation &newLocation);
 
+    /// Returns the current pass through the repeated section surrounding the
+    /// location, or 1 if the location is not in a repeat.
+    int getActiveRepeatNumber(const SystemLocation &location) const;
+
 private:
     DirectionIndex myDirectionIndex;
     RepeatIndexer myRepeatIndex;
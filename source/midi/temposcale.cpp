@@ -0,0 +1,45 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "temposcale.h"
+
+#include <cassert>
+
+TempoScale::TempoScale(int beat_duration, int ticks_per_beat)
+    : myTicksPerBeat(ticks_per_beat)
+{
+    assert(ticks_per_beat > 0);
+    setBeatDuration(beat_duration);
+}
+
+void TempoScale::setBeatDuration(int beat_duration)
+{
+    myBeatDuration = beat_duration;
+
+    int64_t a = beat_duration;
+    int64_t b = myTicksPerBeat;
+    while (b != 0)
+    {
+        const int64_t r = a % b;
+        a = b;
+        b = r;
+    }
+
+    const int64_t divisor = a != 0 ? a : 1;
+    myNumerator = beat_duration / divisor;
+    myDenominator = myTicksPerBeat / divisor;
+}
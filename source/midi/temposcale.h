@@ -0,0 +1,51 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef MIDI_TEMPOSCALE_H
+#define MIDI_TEMPOSCALE_H
+
+#include <cstdint>
+
+/// Converts a number of MIDI ticks to microseconds at the current tempo.
+/// The ratio between the two is reduced whenever the tempo changes, so each
+/// conversion is only an integer multiplication and division.
+class TempoScale
+{
+public:
+    TempoScale(int beat_duration, int ticks_per_beat);
+
+    /// Returns the duration of a beat, in microseconds.
+    int getBeatDuration() const { return myBeatDuration; }
+    /// Sets the duration of a beat, in microseconds.
+    void setBeatDuration(int beat_duration);
+
+    int getTicksPerBeat() const { return myTicksPerBeat; }
+
+    /// Returns the duration of the ticks in microseconds, rounded down.
+    int64_t getTime(int64_t ticks) const
+    {
+        return ticks * myNumerator / myDenominator;
+    }
+
+private:
+    int myBeatDuration;
+    int myTicksPerBeat;
+    int64_t myNumerator;
+    int64_t myDenominator;
+};
+
+#endif
@@ -141,7 +141,11 @@ void CaretPainter::setSystemRect(int index, const QRectF &rect)
 
 QRectF CaretPainter::getCurrentSystemRect() const
 {
-    return mySystemRects.at(myCaret.getLocation().getSystemIndex());
+    const int index = myCaret.getLocation().getSystemIndex();
+    if (index < static_cast<int>(mySystemRects.size()))
+        return mySystemRects[index];
+    else
+        return QRectF();
 }
 
 void CaretPainter::updatePosition()
@@ -162,6 +166,13 @@ void CaretPainter::onLocationChanged()
     if (location.getScore().getSystems().empty())
         return;
 
+    // Redraws are deferred until control returns to the event loop, so the
+    // caret can move to a system (e.g. after systems were removed or inserted)
+    // that hasn't been rendered yet. The caret is updated again once the
+    // score is redrawn.
+    if (location.getSystemIndex() >= static_cast<int>(mySystemRects.size()))
+        return;
+
     const System &system = location.getSystem();
     if (system.getStaves().empty())
         return;
@@ -189,7 +200,7 @@ void CaretPainter::onLocationChanged()
     }
 
     const QRectF oldRect = sceneBoundingRect();
-    setPos(0, mySystemRects.at(location.getSystemIndex()).top() + offset +
+    setPos(0, mySystemRects[location.getSystemIndex()].top() + offset +
            myLayout->getSystemSymbolSpacing() + myLayout->getStaffHeight() -
            myLayout->getTabStaffBelowSpacing() - myLayout->STAFF_BORDER_SPACING -
            myLayout->getTabStaffHeight());
@@ -38,6 +38,8 @@ public:
 
     void addSystemRect(const QRectF &rect);
     void setSystemRect(int index, const QRectF &rect);
+    /// Returns the bounding rectangle of the caret's system, or an empty
+    /// rectangle if that system has not been rendered yet.
     QRectF getCurrentSystemRect() const;
 
     void updatePosition();
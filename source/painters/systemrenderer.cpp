@@ -22,7 +22,6 @@
 #include <app/viewoptions.h>
 #include <boost/algorithm/clamp.hpp>
 #include <boost/lexical_cast.hpp>
-#include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 #include <painters/antialiasedpathitem.h>
 #include <painters/barlinepainter.h>
@@ -67,6 +66,8 @@ SystemRenderer::SystemRenderer(const ScoreArea *score_area, const Score &score,
       myParentStaff(nullptr),
       myMusicNotationFont(MusicFont::getFont(MusicFont::DEFAULT_FONT_SIZE)),
       myMusicFontMetrics(myMusicNotationFont),
+      myGraceNoteFont(MusicFont::getFont(MusicFont::GRACE_NOTE_SIZE)),
+      myGraceNoteFontMetrics(myGraceNoteFont),
       myPlainTextFont("Liberation Sans"),
       mySymbolTextFont("Liberation Sans"),
       myRehearsalSignFont("Helvetica")
@@ -748,7 +749,8 @@ void SystemRenderer::drawLegato(const Staff &staff, const LayoutInfo &layout)
 {
     for (const Voice &voice : staff.getVoices())
     {
-        std::map<int, int> arcs;
+        // The start position of the current arc on each string, or -1.
+        myArcStarts.assign(staff.getStringCount(), -1);
 
         for (const Position &pos : voice.getPositions())
         {
@@ -757,19 +759,22 @@ void SystemRenderer::drawLegato(const Staff &staff, const LayoutInfo &layout)
             for (const Note &note : pos.getNotes())
             {
                 const int string = note.getString();
+                if (string >= static_cast<int>(myArcStarts.size()))
+                    myArcStarts.resize(string + 1, -1);
+                int &arcStart = myArcStarts[string];
 
                 if (note.hasProperty(Note::HammerOnOrPullOff) ||
                     note.hasProperty(Note::LegatoSlide))
                 {
                     // Set the start position of an arc, if necessary.
-                    if (arcs.find(string) == arcs.end())
-                        arcs[string] = position;
+                    if (arcStart < 0)
+                        arcStart = position;
                 }
                 // If an arc was already started and the current note is not
                 // a hammeron / pulloff, end the arc.
-                else if (arcs.find(string) != arcs.end())
+                else if (arcStart >= 0)
                 {
-                    const int startPos = arcs.find(string)->second;
+                    const int startPos = arcStart;
 
                     const double left = layout.getPositionX(startPos);
                     const double width = layout.getPositionX(position) - left;
@@ -792,7 +797,7 @@ void SystemRenderer::drawLegato(const Staff &staff, const LayoutInfo &layout)
                     arc->setPos(left + layout.getPositionSpacing() / 2, y);
                     arc->setParentItem(myParentStaff);
 
-                    arcs.erase(arcs.find(string));
+                    arcStart = -1;
                 }
 
                 // Draw hammerons/pulloffs to nowhere.
@@ -811,8 +816,7 @@ void SystemRenderer::drawLegato(const Staff &staff, const LayoutInfo &layout)
                                 layout.getTabLine(string) - 2);
                     arc->setParentItem(myParentStaff);
 
-                    if (arcs.find(string) != arcs.end())
-                        arcs.erase(arcs.find(string));
+                    arcStart = -1;
                 }
             }
         }
@@ -1380,20 +1384,15 @@ void SystemRenderer::drawStdNotation(const System &system, const Staff &staff,
 
     const std::vector<StdNotationNote> &notes = layout.getStdNotationNotes();
 
-    std::map<int, double> minNoteLocations;
-    std::map<int, double> maxNoteLocations;
-    std::map<int, double> noteHeadWidths;
-    std::map<int, double> noteHeadCenters;
-
-    QFont default_font(MusicFont::getFont(MusicFont::DEFAULT_FONT_SIZE));
-    QFont grace_font(MusicFont::getFont(MusicFont::GRACE_NOTE_SIZE));
-    QFontMetricsF default_fm(default_font);
-    QFontMetricsF grace_fm(grace_font);
+    // Reuse the buffer from the previous staff.
+    myNoteColumns.assign(layout.getNumPositions(), NoteColumn());
 
     for (const StdNotationNote &note : notes)
     {
-        const QFont *font = note.isGraceNote() ? &grace_font : &default_font;
-        const QFontMetricsF *fm = note.isGraceNote() ? &grace_fm : &default_fm;
+        const QFont *font =
+            note.isGraceNote() ? &myGraceNoteFont : &myMusicNotationFont;
+        const QFontMetricsF *fm = note.isGraceNote() ? &myGraceNoteFontMetrics
+                                                     : &myMusicFontMetrics;
 
         const QChar note_head_char = note.getNoteHeadSymbol();
         const double note_head_width = fm->width(note_head_char);
@@ -1496,16 +1495,18 @@ void SystemRenderer::drawStdNotation(const System &system, const Staff &staff,
             text_item->setParentItem(myParentStaff);
         }
 
-        const int position = note.getPosition();
-        minNoteLocations[position] = std::min(minNoteLocations[position],
-                                              note.getY());
-        maxNoteLocations[position] = std::max(maxNoteLocations[position],
-                                              note.getY());
-        noteHeadWidths[position] = note_head_width;
-        noteHeadCenters[position] = x;
+        const size_t position = note.getPosition();
+        if (position >= myNoteColumns.size())
+            myNoteColumns.resize(position + 1);
+
+        NoteColumn &column = myNoteColumns[position];
+        column.myHasNotes = true;
+        column.myMinY = std::min(column.myMinY, note.getY());
+        column.myMaxY = std::max(column.myMaxY, note.getY());
+        column.myNoteHeadWidth = note_head_width;
     }
 
-    drawLedgerLines(layout, minNoteLocations, maxNoteLocations, noteHeadWidths);
+    drawLedgerLines(layout);
 
     for (int v = 0; v < Staff::NUM_VOICES; ++v)
     {
@@ -1760,35 +1761,36 @@ void SystemRenderer::drawRest(const Position &pos, double x, const LayoutInfo &l
     group->setParentItem(myParentStaff);
 }
 
-void SystemRenderer::drawLedgerLines(
-        const LayoutInfo &layout,
-        const std::map<int, double> &minNoteLocations,
-        const std::map<int, double> &maxNoteLocations,
-        const std::map<int, double> &noteHeadWidths)
+void SystemRenderer::drawLedgerLines(const LayoutInfo &layout)
 {
     QPainterPath path;
 
-    for (const int position : minNoteLocations | boost::adaptors::map_keys)
+    for (size_t position = 0; position < myNoteColumns.size(); ++position)
     {
-        const double highestNote = minNoteLocations.at(position);
-        const double lowestNote = maxNoteLocations.at(position);
+        const NoteColumn &column = myNoteColumns[position];
+        if (!column.myHasNotes)
+            continue;
 
-        const int numLedgerLinesTop = -highestNote /
+        const int numLedgerLinesTop = -column.myMinY /
                 LayoutInfo::STD_NOTATION_LINE_SPACING;
         const int numLedgerLinesBottom =
-                (lowestNote - layout.getStdNotationStaffHeight()) /
+                (column.myMaxY - layout.getStdNotationStaffHeight()) /
                 LayoutInfo::STD_NOTATION_LINE_SPACING;
 
-        std::vector<double> ledgerLineLocations;
+        const double ledgerLineWidth = column.myNoteHeadWidth * 2;
+        const double x = layout.getPositionX(position) +
+                0.5 * (layout.getPositionSpacing() - ledgerLineWidth);
+
+        auto addLedgerLine = [&](double location) {
+            path.moveTo(x, location);
+            path.lineTo(x + ledgerLineWidth, location);
+        };
 
         if (numLedgerLinesTop > 0)
         {
             const double topLine = layout.getTopStdNotationLine();
             for (int i = 1; i <= numLedgerLinesTop; ++i)
-            {
-                ledgerLineLocations.push_back(
-                            topLine - i * LayoutInfo::STD_NOTATION_LINE_SPACING);
-            }
+                addLedgerLine(topLine - i * LayoutInfo::STD_NOTATION_LINE_SPACING);
         }
 
         if (numLedgerLinesBottom > 0)
@@ -1796,20 +1798,10 @@ void SystemRenderer::drawLedgerLines(
             const int bottomLine = layout.getBottomStdNotationLine();
             for (int i = 1; i <= numLedgerLinesBottom; ++i)
             {
-                ledgerLineLocations.push_back(bottomLine +
-                            i * LayoutInfo::STD_NOTATION_LINE_SPACING);
+                addLedgerLine(bottomLine +
+                              i * LayoutInfo::STD_NOTATION_LINE_SPACING);
             }
         }
-
-        const double ledgerLineWidth = noteHeadWidths.at(position) * 2;
-        const double x = layout.getPositionX(position) +
-                0.5 * (layout.getPositionSpacing() - ledgerLineWidth);
-
-        for (double location : ledgerLineLocations)
-        {
-            path.moveTo(x, location);
-            path.lineTo(x + ledgerLineWidth, location);
-        }
     }
 
     auto ledgerlines = new QGraphicsPathItem(path);
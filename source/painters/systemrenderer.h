@@ -18,11 +18,11 @@
 #ifndef PAINTERS_SYSTEMRENDERER_H
 #define PAINTERS_SYSTEMRENDERER_H
 
-#include <map>
 #include <painters/layoutinfo.h>
 #include <painters/musicfont.h>
 #include <QFontMetricsF>
 #include <score/staff.h>
+#include <vector>
 
 class QGraphicsItem;
 class QGraphicsItemGroup;
@@ -175,11 +175,9 @@ private:
     /// Draws a rest symbol.
     void drawRest(const Position &pos, double x, const LayoutInfo &layout);
 
-    /// Draws ledger lines for all positions in the staff.
-    void drawLedgerLines(const LayoutInfo &layout,
-                         const std::map<int, double> &minNoteLocations,
-                         const std::map<int, double> &maxNoteLocations,
-                         const std::map<int, double> &noteHeadWidths);
+    /// Draws ledger lines for all positions in the staff, using the note
+    /// locations that were recorded in myNoteColumns.
+    void drawLedgerLines(const LayoutInfo &layout);
 
     /// Draws all slides in a staff.
     void drawSlides(const Staff &staff, const LayoutInfo &layout);
@@ -197,9 +195,31 @@ private:
 
     QFont myMusicNotationFont;
     QFontMetricsF myMusicFontMetrics;
+    QFont myGraceNoteFont;
+    QFontMetricsF myGraceNoteFontMetrics;
     QFont myPlainTextFont;
     QFont mySymbolTextFont;
     QFont myRehearsalSignFont;
+
+    /// The range of notes at a position in the standard notation staff.
+    struct NoteColumn
+    {
+        NoteColumn()
+            : myHasNotes(false), myMinY(0), myMaxY(0), myNoteHeadWidth(0)
+        {
+        }
+
+        bool myHasNotes;
+        double myMinY;
+        double myMaxY;
+        double myNoteHeadWidth;
+    };
+
+    /// Scratch buffers that are cleared for each staff rather than being
+    /// reallocated, so that their memory is reused when the same renderer
+    /// draws a sequence of systems.
+    std::vector<NoteColumn> myNoteColumns;
+    std::vector<int> myArcStarts;
 };
 
 #endif
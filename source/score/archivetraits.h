@@ -0,0 +1,38 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_ARCHIVETRAITS_H
+#define SCORE_ARCHIVETRAITS_H
+
+#include <type_traits>
+
+namespace ScoreUtils
+{
+class InputArchive;
+
+/// Returns whether the archive is loading the object rather than saving it.
+/// Saving may happen while another thread is reading the score, so members
+/// that are serialized through temporaries must only be written to when
+/// loading.
+template <class Archive>
+constexpr bool isLoading()
+{
+    return std::is_same<Archive, InputArchive>::value;
+}
+}
+
+#endif
@@ -0,0 +1,265 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "contenthash.h"
+
+#include "alternateending.h"
+#include "barline.h"
+#include "chordtext.h"
+#include "direction.h"
+#include "dynamic.h"
+#include "irregulargrouping.h"
+#include "playerchange.h"
+#include "staff.h"
+#include "tempomarker.h"
+#include "textitem.h"
+
+namespace ScoreUtils
+{
+ContentHasher::ContentHasher() : myHash(0xcbf29ce484222325ULL)
+{
+}
+
+void ContentHasher::combine(uint64_t value)
+{
+    // Mix the bits of the value (using the finalizer from MurmurHash3) before
+    // combining it with the hash, as in FNV-1a.
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+
+    myHash = (myHash ^ value) * 0x100000001b3ULL;
+}
+
+void ContentHasher::add(const std::string &str)
+{
+    add(str.size());
+    for (char c : str)
+        add(static_cast<unsigned char>(c));
+}
+
+void ContentHasher::add(const ActivePlayer &player)
+{
+    add(player.getPlayerNumber());
+    add(player.getInstrumentNumber());
+}
+
+void ContentHasher::add(const AlternateEnding &ending)
+{
+    add(ending.getPosition());
+    addRange(ending.getNumbers());
+    add(ending.hasDaCapo());
+    add(ending.hasDalSegno());
+    add(ending.hasDalSegnoSegno());
+}
+
+void ContentHasher::add(const ArtificialHarmonic &harmonic)
+{
+    add(harmonic.getKey());
+    add(harmonic.getVariation());
+    add(harmonic.getOctave());
+}
+
+void ContentHasher::add(const Barline &barline)
+{
+    add(barline.getPosition());
+    add(barline.getBarType());
+    add(barline.getRepeatCount());
+    add(barline.getKeySignature());
+    add(barline.getTimeSignature());
+
+    add(barline.hasRehearsalSign());
+    if (barline.hasRehearsalSign())
+        add(barline.getRehearsalSign());
+}
+
+void ContentHasher::add(const Bend &bend)
+{
+    add(bend.getType());
+    add(bend.getBentPitch());
+    add(bend.getReleasePitch());
+    add(bend.getDuration());
+    add(bend.getStartPoint());
+    add(bend.getEndPoint());
+}
+
+void ContentHasher::add(const ChordName &chord)
+{
+    add(chord.getTonicKey());
+    add(chord.getTonicVariation());
+    add(chord.getBassKey());
+    add(chord.getBassVariation());
+    add(chord.getFormula());
+    for (int i = 0; i < ChordName::NumModifications; ++i)
+        add(chord.hasModification(
+            static_cast<ChordName::FormulaModification>(i)));
+    add(chord.hasBrackets());
+    add(chord.isNoChord());
+}
+
+void ContentHasher::add(const ChordText &chord)
+{
+    add(chord.getPosition());
+    add(chord.getChordName());
+}
+
+void ContentHasher::add(const Direction &direction)
+{
+    add(direction.getPosition());
+    addRange(direction.getSymbols());
+}
+
+void ContentHasher::add(const DirectionSymbol &symbol)
+{
+    add(symbol.getSymbolType());
+    add(symbol.getActiveSymbolType());
+    add(symbol.getRepeatNumber());
+}
+
+void ContentHasher::add(const Dynamic &dynamic)
+{
+    add(dynamic.getPosition());
+    add(dynamic.getVolume());
+}
+
+void ContentHasher::add(const IrregularGrouping &group)
+{
+    add(group.getPosition());
+    add(group.getLength());
+    add(group.getNotesPlayed());
+    add(group.getNotesPlayedOver());
+}
+
+void ContentHasher::add(const KeySignature &key)
+{
+    add(key.getKeyType());
+    add(key.getNumAccidentals(true));
+    add(key.usesSharps());
+    add(key.isVisible());
+    add(key.isCancellation());
+}
+
+void ContentHasher::add(const LeftHandFingering &fingering)
+{
+    add(fingering.getFingerNumber());
+    add(fingering.getDisplayPosition());
+}
+
+void ContentHasher::add(const Note &note)
+{
+    add(note.getString());
+    add(note.getFretNumber());
+    for (int i = 0; i < Note::NumSimpleProperties; ++i)
+        add(note.hasProperty(static_cast<Note::SimpleProperty>(i)));
+
+    add(note.hasTrill());
+    if (note.hasTrill())
+        add(note.getTrilledFret());
+
+    add(note.hasTappedHarmonic());
+    if (note.hasTappedHarmonic())
+        add(note.getTappedHarmonicFret());
+
+    add(note.hasArtificialHarmonic());
+    if (note.hasArtificialHarmonic())
+        add(note.getArtificialHarmonic());
+
+    add(note.hasBend());
+    if (note.hasBend())
+        add(note.getBend());
+
+    add(note.hasLeftHandFingering());
+    if (note.hasLeftHandFingering())
+        add(note.getLeftHandFingering());
+}
+
+void ContentHasher::add(const Position &position)
+{
+    add(position.getPosition());
+    add(position.getDurationType());
+    for (int i = 0; i < Position::NumSimpleProperties; ++i)
+        add(position.hasProperty(static_cast<Position::SimpleProperty>(i)));
+
+    add(position.hasMultiBarRest());
+    if (position.hasMultiBarRest())
+        add(position.getMultiBarRestCount());
+
+    addRange(position.getNotes());
+}
+
+void ContentHasher::add(const RehearsalSign &sign)
+{
+    add(sign.getLetters());
+    add(sign.getDescription());
+}
+
+void ContentHasher::add(const TempoMarker &marker)
+{
+    add(marker.getPosition());
+    add(marker.getMarkerType());
+    add(marker.getBeatType());
+    add(marker.getListessoBeatType());
+    add(marker.getTripletFeel());
+    add(marker.getAlterationOfPace());
+    add(marker.getBeatsPerMinute());
+    add(marker.getDescription());
+}
+
+void ContentHasher::add(const TextItem &text)
+{
+    add(text.getPosition());
+    add(text.getContents());
+}
+
+void ContentHasher::add(const TimeSignature &time)
+{
+    add(time.getMeterType());
+    add(time.getBeatsPerMeasure());
+    add(time.getBeatValue());
+    addRange(time.getBeamingPattern());
+    add(time.getNumPulses());
+    add(time.isVisible());
+}
+
+void ContentHasher::add(const Staff &staff)
+{
+    add(staff.getContentHash());
+}
+
+void ContentHasher::add(const Voice &voice)
+{
+    add(voice.getContentHash());
+}
+
+CachedContentHash::CachedContentHash() : myHash(0)
+{
+}
+
+CachedContentHash::CachedContentHash(const CachedContentHash &other)
+    : myHash(other.myHash.load())
+{
+}
+
+CachedContentHash &CachedContentHash::operator=(
+    const CachedContentHash &other)
+{
+    myHash.store(other.myHash.load());
+    return *this;
+}
+}
@@ -0,0 +1,150 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCORE_CONTENTHASH_H
+#define SCORE_CONTENTHASH_H
+
+#include <atomic>
+#include <boost/range/size.hpp>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+class ActivePlayer;
+class AlternateEnding;
+class ArtificialHarmonic;
+class Barline;
+class Bend;
+class ChordName;
+class ChordText;
+class Direction;
+class DirectionSymbol;
+class Dynamic;
+class IrregularGrouping;
+class KeySignature;
+class LeftHandFingering;
+class Note;
+class Position;
+class RehearsalSign;
+class Staff;
+class TempoMarker;
+class TextItem;
+class TimeSignature;
+class Voice;
+
+namespace ScoreUtils
+{
+/// Computes a 64-bit hash of the contents of score objects. The objects are
+/// only visited through their const accessors.
+class ContentHasher
+{
+public:
+    ContentHasher();
+
+    uint64_t getHash() const { return myHash; }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value ||
+                            std::is_enum<T>::value>::type
+    add(T value)
+    {
+        combine(static_cast<uint64_t>(value));
+    }
+
+    void add(const std::string &str);
+
+    /// Adds the number of objects in the range, followed by each object.
+    template <typename Range>
+    void addRange(const Range &range)
+    {
+        add(boost::size(range));
+        for (const auto &obj : range)
+            add(obj);
+    }
+
+    void add(const ActivePlayer &player);
+    void add(const AlternateEnding &ending);
+    void add(const ArtificialHarmonic &harmonic);
+    void add(const Barline &barline);
+    void add(const Bend &bend);
+    void add(const ChordName &chord);
+    void add(const ChordText &chord);
+    void add(const Direction &direction);
+    void add(const DirectionSymbol &symbol);
+    void add(const Dynamic &dynamic);
+    void add(const IrregularGrouping &group);
+    void add(const KeySignature &key);
+    void add(const LeftHandFingering &fingering);
+    void add(const Note &note);
+    void add(const Position &position);
+    void add(const RehearsalSign &sign);
+    void add(const TempoMarker &marker);
+    void add(const TextItem &text);
+    void add(const TimeSignature &time);
+    /// Uses the staff's cached hash.
+    void add(const Staff &staff);
+    /// Uses the voice's cached hash.
+    void add(const Voice &voice);
+
+private:
+    void combine(uint64_t value);
+
+    uint64_t myHash;
+};
+
+/// A content hash that is computed when first requested, and is cleared by
+/// the owning object whenever it is modified. Copying the owner copies the
+/// hash along with the contents.
+class CachedContentHash
+{
+public:
+    CachedContentHash();
+    CachedContentHash(const CachedContentHash &other);
+    CachedContentHash &operator=(const CachedContentHash &other);
+
+    /// Returns the cached hash, or computes and stores it if needed. In debug
+    /// builds, a cached hash is checked against the object's contents to
+    /// catch modifications that did not clear it.
+    template <typename Function>
+    uint64_t get(Function compute) const
+    {
+        uint64_t hash = myHash.load();
+        if (hash == 0)
+        {
+            hash = nonZero(compute());
+            myHash.store(hash);
+        }
+#ifndef NDEBUG
+        else
+            assert(hash == nonZero(compute()));
+#endif
+
+        return hash;
+    }
+
+    void reset() { myHash.store(0); }
+
+private:
+    /// Zero is used to indicate that the hash needs to be computed.
+    static uint64_t nonZero(uint64_t hash) { return hash ? hash : 1; }
+
+    mutable std::atomic<uint64_t> myHash;
+};
+}
+
+#endif
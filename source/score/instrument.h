@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include "fileversion.h"
+#include "internedstring.h"
 #include <string>
 
 class Instrument
@@ -43,7 +44,7 @@ public:
     void setMidiPreset(uint8_t preset);
 
 private:
-    std::string myDescription;
+    InternedString myDescription;
     uint8_t myMidiPreset;
 };
 
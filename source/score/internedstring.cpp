@@ -0,0 +1,112 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "internedstring.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+struct PoolEntry
+{
+    PoolEntry() : myNumOwners(0) {}
+
+    std::weak_ptr<const std::string> myHandle;
+    /// The number of handles that were created for the string and have not
+    /// yet been released. This can briefly be more than one if the string is
+    /// interned again while its previous handle is being released.
+    int myNumOwners;
+};
+
+/// Maps each unique string to the handle that shares it. An entry is removed
+/// when the last InternedString that refers to it is destroyed.
+struct StringPool
+{
+    std::mutex myMutex;
+    std::unordered_map<std::string, PoolEntry> myStrings;
+};
+
+StringPool &getPool()
+{
+    // This is intentionally never destroyed, since interned strings may
+    // outlive other static objects.
+    static StringPool *pool = new StringPool();
+    return *pool;
+}
+
+/// Removes the pool's entry for a string after its last reference is released.
+struct Release
+{
+    void operator()(const std::string *str) const
+    {
+        StringPool &pool = getPool();
+        std::lock_guard<std::mutex> lock(pool.myMutex);
+
+        // The string may have been interned again before the lock was
+        // acquired, in which case the entry is still in use.
+        auto it = pool.myStrings.find(*str);
+        if (--it->second.myNumOwners == 0)
+            pool.myStrings.erase(it);
+    }
+};
+
+std::shared_ptr<const std::string> intern(const std::string &str)
+{
+    // Empty strings are very common, so share a single instance that isn't
+    // stored in the pool.
+    static const std::shared_ptr<const std::string> theEmptyString =
+        std::make_shared<const std::string>();
+    if (str.empty())
+        return theEmptyString;
+
+    StringPool &pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.myMutex);
+
+    auto it = pool.myStrings.emplace(str, PoolEntry()).first;
+    PoolEntry &entry = it->second;
+    if (auto existing = entry.myHandle.lock())
+        return existing;
+
+    // The map's key is the shared storage for the string, since the key's
+    // address doesn't change until the entry is erased.
+    std::shared_ptr<const std::string> handle(&it->first, Release());
+    entry.myHandle = handle;
+    ++entry.myNumOwners;
+    return handle;
+}
+}
+
+InternedString::InternedString() : myString(intern(std::string()))
+{
+}
+
+InternedString::InternedString(const std::string &str) : myString(intern(str))
+{
+}
+
+InternedString::InternedString(const char *str)
+    : myString(intern(std::string(str)))
+{
+}
+
+size_t InternedString::getPoolSize()
+{
+    StringPool &pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.myMutex);
+    return pool.myStrings.size();
+}
@@ -0,0 +1,69 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCORE_INTERNEDSTRING_H
+#define SCORE_INTERNEDSTRING_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+/// An immutable string that shares its storage with every other
+/// InternedString with the same contents, such as a player name that appears
+/// in the score, the undo history, and the clipboard.
+/// Copying an interned string does not allocate memory, and equal strings can
+/// be compared (or hashed) by their address.
+class InternedString
+{
+public:
+    /// Creates an empty string.
+    InternedString();
+    InternedString(const std::string &str);
+    InternedString(const char *str);
+
+    const std::string &str() const { return *myString; }
+    operator const std::string &() const { return *myString; }
+
+    bool empty() const { return myString->empty(); }
+
+    bool operator==(const InternedString &other) const
+    {
+        return myString == other.myString;
+    }
+    bool operator!=(const InternedString &other) const
+    {
+        return myString != other.myString;
+    }
+
+    /// Hashes the string by its address, for use in e.g. an unordered_map.
+    struct Hash
+    {
+        size_t operator()(const InternedString &str) const
+        {
+            return std::hash<const std::string *>()(str.myString.get());
+        }
+    };
+
+    /// Returns the number of unique strings that are currently interned.
+    static size_t getPoolSize();
+
+private:
+    std::shared_ptr<const std::string> myString;
+};
+
+#endif
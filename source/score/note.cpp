@@ -17,6 +17,7 @@
 
 #include "note.h"
 
+#include <cassert>
 #include <map>
 #include <ostream>
 #include <sstream>
@@ -25,6 +26,9 @@
 const int Note::MIN_FRET_NUMBER = 0;
 const int Note::MAX_FRET_NUMBER = 29;
 
+static_assert(Note::NumSimpleProperties <= 32,
+              "The simple properties must fit in a 32-bit integer");
+
 namespace {
     /// Mapping of frets to pitch offsets (counted in half-steps or frets).
     /// For example, the natural harmonic at the 7th fret is an octave and
@@ -40,16 +44,40 @@ Note::Note()
     : myString(0),
       myFretNumber(0),
       myTrilledFret(-1),
-      myTappedHarmonicFret(-1)
+      myTappedHarmonicFret(-1),
+      mySimpleProperties(0)
 {
 }
 
 Note::Note(int string, int fretNumber)
-    : myString(string),
-      myFretNumber(fretNumber),
+    : myString(static_cast<int8_t>(string)),
+      myFretNumber(static_cast<int8_t>(fretNumber)),
       myTrilledFret(-1),
-      myTappedHarmonicFret(-1)
+      myTappedHarmonicFret(-1),
+      mySimpleProperties(0)
+{
+}
+
+Note::Note(const Note &other)
+    : myString(other.myString),
+      myFretNumber(other.myFretNumber),
+      myTrilledFret(other.myTrilledFret),
+      myTappedHarmonicFret(other.myTappedHarmonicFret),
+      mySimpleProperties(other.mySimpleProperties)
+{
+    if (other.myRareProperties)
+        myRareProperties.reset(new RareProperties(*other.myRareProperties));
+}
+
+Note &Note::operator=(const Note &other)
 {
+    if (this != &other)
+    {
+        Note copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
 }
 
 bool Note::operator==(const Note &other) const
@@ -58,8 +86,11 @@ bool Note::operator==(const Note &other) const
            mySimpleProperties == other.mySimpleProperties &&
            myTrilledFret == other.myTrilledFret &&
            myTappedHarmonicFret == other.myTappedHarmonicFret &&
-           myArtificialHarmonic == other.myArtificialHarmonic &&
-           myBend == other.myBend;
+           hasArtificialHarmonic() == other.hasArtificialHarmonic() &&
+           (!hasArtificialHarmonic() ||
+            getArtificialHarmonic() == other.getArtificialHarmonic()) &&
+           hasBend() == other.hasBend() &&
+           (!hasBend() || getBend() == other.getBend());
 }
 
 int Note::getString() const
@@ -69,7 +100,7 @@ int Note::getString() const
 
 void Note::setString(int string)
 {
-    myString = string;
+    myString = static_cast<int8_t>(string);
 }
 
 int Note::getFretNumber() const
@@ -79,12 +110,12 @@ int Note::getFretNumber() const
 
 void Note::setFretNumber(int fret)
 {
-    myFretNumber = fret;
+    myFretNumber = static_cast<int8_t>(fret);
 }
 
 bool Note::hasProperty(SimpleProperty property) const
 {
-    return mySimpleProperties.test(property);
+    return (mySimpleProperties & (1u << property)) != 0;
 }
 
 void Note::setProperty(SimpleProperty property, bool set)
@@ -96,30 +127,33 @@ void Note::setProperty(SimpleProperty property, bool set)
         if (property >= Octave8va && property <= Octave15mb)
         {
             for (int p = Octave8va; p <= Octave15mb; ++p)
-                mySimpleProperties.set(static_cast<SimpleProperty>(p), false);
+                mySimpleProperties &= ~(1u << p);
         }
 
         // Clear all hammeron/pulloff properties.
         if (property >= HammerOnOrPullOff && property <= PullOffToNowhere)
         {
             for (int p = HammerOnOrPullOff; p <= PullOffToNowhere; ++p)
-                mySimpleProperties.set(static_cast<SimpleProperty>(p), false);
+                mySimpleProperties &= ~(1u << p);
         }
 
         // Clear any mutually-exclusive slide types.
         if (property == SlideIntoFromAbove)
-            mySimpleProperties.set(SlideIntoFromBelow, false);
+            mySimpleProperties &= ~(1u << SlideIntoFromBelow);
         if (property == SlideIntoFromBelow)
-            mySimpleProperties.set(SlideIntoFromAbove, false);
+            mySimpleProperties &= ~(1u << SlideIntoFromAbove);
 
         if (property >= ShiftSlide && property <= SlideOutOfUpwards)
         {
             for (int p = ShiftSlide; p <= SlideOutOfUpwards; ++p)
-                mySimpleProperties.set(static_cast<SimpleProperty>(p), false);
+                mySimpleProperties &= ~(1u << p);
         }
     }
 
-    mySimpleProperties.set(property, set);
+    if (set)
+        mySimpleProperties |= 1u << property;
+    else
+        mySimpleProperties &= ~(1u << property);
 }
 
 bool Note::hasTrill() const
@@ -140,7 +174,7 @@ void Note::setTrilledFret(int fret)
     if (fret < 0)
         throw std::out_of_range("Invalid fret number");
 
-    myTrilledFret = fret;
+    myTrilledFret = static_cast<int8_t>(fret);
 }
 
 void Note::clearTrill()
@@ -166,7 +200,7 @@ void Note::setTappedHarmonicFret(int fret)
     if (fret < 0)
         throw std::out_of_range("Invalid fret number");
 
-    myTappedHarmonicFret = fret;
+    myTappedHarmonicFret = static_cast<int8_t>(fret);
 }
 
 void Note::clearTappedHarmonic()
@@ -176,62 +210,98 @@ void Note::clearTappedHarmonic()
 
 bool Note::hasArtificialHarmonic() const
 {
-    return myArtificialHarmonic.is_initialized();
+    return myRareProperties &&
+           myRareProperties->myArtificialHarmonic.is_initialized();
 }
 
 const ArtificialHarmonic &Note::getArtificialHarmonic() const
 {
-    return myArtificialHarmonic.get();
+    assert(hasArtificialHarmonic());
+    return myRareProperties->myArtificialHarmonic.get();
 }
 
 void Note::setArtificialHarmonic(const ArtificialHarmonic &harmonic)
 {
-    myArtificialHarmonic = harmonic;
+    getRareProperties().myArtificialHarmonic = harmonic;
 }
 
 void Note::clearArtificialHarmonic()
 {
-    myArtificialHarmonic.reset();
+    if (myRareProperties)
+    {
+        myRareProperties->myArtificialHarmonic.reset();
+        releaseRareProperties();
+    }
 }
 
 bool Note::hasBend() const
 {
-    return myBend.is_initialized();
+    return myRareProperties && myRareProperties->myBend.is_initialized();
 }
 
 const Bend &Note::getBend() const
 {
-    return myBend.get();
+    assert(hasBend());
+    return myRareProperties->myBend.get();
 }
 
 void Note::setBend(const Bend &bend)
 {
-    myBend = bend;
+    getRareProperties().myBend = bend;
 }
 
 void Note::clearBend()
 {
-    myBend.reset();
+    if (myRareProperties)
+    {
+        myRareProperties->myBend.reset();
+        releaseRareProperties();
+    }
 }
 
 bool Note::hasLeftHandFingering() const
 {
-    return myLeftHandFingering.is_initialized();
+    return myRareProperties &&
+           myRareProperties->myLeftHandFingering.is_initialized();
 }
 
 const LeftHandFingering &Note::getLeftHandFingering() const
 {
-    return myLeftHandFingering.get();
+    assert(hasLeftHandFingering());
+    return myRareProperties->myLeftHandFingering.get();
 }
 
 void Note::setLeftHandFingering(const LeftHandFingering &fingering)
 {
-    myLeftHandFingering = fingering;
+    getRareProperties().myLeftHandFingering = fingering;
 }
 
 void Note::clearLeftHandFingering()
 {
-    myLeftHandFingering.reset();
+    if (myRareProperties)
+    {
+        myRareProperties->myLeftHandFingering.reset();
+        releaseRareProperties();
+    }
+}
+
+bool Note::RareProperties::empty() const
+{
+    return !myArtificialHarmonic && !myBend && !myLeftHandFingering;
+}
+
+Note::RareProperties &Note::getRareProperties()
+{
+    if (!myRareProperties)
+        myRareProperties.reset(new RareProperties());
+
+    return *myRareProperties;
+}
+
+void Note::releaseRareProperties()
+{
+    if (myRareProperties && myRareProperties->empty())
+        myRareProperties.reset();
 }
 
 std::ostream &operator<<(std::ostream &os, const Note &note)
@@ -330,7 +400,7 @@ ChordName::Variation ArtificialHarmonic::getVariation() const
     return myVariation;
 }
 
-ArtificialHarmonic::Octave ArtificialHarmonic::getOctave()
+ArtificialHarmonic::Octave ArtificialHarmonic::getOctave() const
 {
     return myOctave;
 }
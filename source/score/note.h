@@ -18,11 +18,14 @@
 #ifndef SCORE_NOTE_H
 #define SCORE_NOTE_H
 
+#include "archivetraits.h"
 #include <bitset>
 #include <boost/optional.hpp>
 #include "chordname.h"
+#include <cstdint>
 #include "fileversion.h"
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 class ArtificialHarmonic
@@ -43,7 +46,7 @@ public:
 
     ChordName::Key getKey() const;
     ChordName::Variation getVariation() const;
-    Octave getOctave();
+    Octave getOctave() const;
 
     template <class Archive>
     void serialize(Archive &ar, const FileVersion /*version*/)
@@ -193,6 +196,11 @@ public:
 
     Note();
     Note(int string, int fretNumber);
+    Note(const Note &other);
+    Note(Note &&other) = default;
+
+    Note &operator=(const Note &other);
+    Note &operator=(Note &&other) = default;
 
     bool operator==(const Note &other) const;
 
@@ -263,28 +271,57 @@ public:
     static const int MAX_FRET_NUMBER;
 
 private:
-    int myString;
-    int myFretNumber;
-    std::bitset<NumSimpleProperties> mySimpleProperties;
-    int myTrilledFret;
-    int myTappedHarmonicFret;
-    boost::optional<ArtificialHarmonic> myArtificialHarmonic;
-    boost::optional<Bend> myBend;
-    boost::optional<LeftHandFingering> myLeftHandFingering;
+    /// Properties that very few notes have. These are stored separately so
+    /// that they don't increase the size of every note.
+    struct RareProperties
+    {
+        bool empty() const;
+
+        boost::optional<ArtificialHarmonic> myArtificialHarmonic;
+        boost::optional<Bend> myBend;
+        boost::optional<LeftHandFingering> myLeftHandFingering;
+    };
+
+    /// Returns the rare properties, creating them if necessary.
+    RareProperties &getRareProperties();
+    /// Frees the rare properties if none of them are set.
+    void releaseRareProperties();
+
+    int8_t myString;
+    int8_t myFretNumber;
+    int8_t myTrilledFret;
+    int8_t myTappedHarmonicFret;
+    uint32_t mySimpleProperties;
+    std::unique_ptr<RareProperties> myRareProperties;
 };
 
 template <class Archive>
 void Note::serialize(Archive &ar, const FileVersion version)
 {
+    // Use the same file format as the original (uncompressed) layout.
+    std::bitset<NumSimpleProperties> properties(mySimpleProperties);
+    RareProperties rare;
+    if (myRareProperties)
+        rare = *myRareProperties;
+
     ar("string", myString);
     ar("fret", myFretNumber);
-    ar("properties", mySimpleProperties);
+    ar("properties", properties);
     ar("trill", myTrilledFret);
     ar("tapped_harmonic", myTappedHarmonicFret);
-    ar("artificial_harmonic", myArtificialHarmonic);
-    ar("bend", myBend);
+    ar("artificial_harmonic", rare.myArtificialHarmonic);
+    ar("bend", rare.myBend);
     if (version >= FileVersion::LEFT_HAND_FINGERING)
-        ar("finger_hint", myLeftHandFingering);
+        ar("finger_hint", rare.myLeftHandFingering);
+
+    if (ScoreUtils::isLoading<Archive>())
+    {
+        mySimpleProperties = static_cast<uint32_t>(properties.to_ulong());
+        if (rare.empty())
+            myRareProperties.reset();
+        else
+            getRareProperties() = rare;
+    }
 }
 
 /// Useful utility functions for working with natural and tapped harmonics.
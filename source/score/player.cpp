@@ -41,6 +41,11 @@ const std::string &Player::getDescription() const
     return myDescription;
 }
 
+const InternedString &Player::getInternedDescription() const
+{
+    return myDescription;
+}
+
 void Player::setDescription(const std::string &description)
 {
     myDescription = description;
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include "fileversion.h"
+#include "internedstring.h"
 #include <string>
 #include "tuning.h"
 
@@ -35,6 +36,9 @@ public:
 
     /// Returns a description of the player (e.g. "Rhythm Guitar 1").
     const std::string &getDescription() const;
+    /// Returns the description as an interned string, which can be compared
+    /// with other players' descriptions without comparing characters.
+    const InternedString &getInternedDescription() const;
     /// Sets the description of the player.
     void setDescription(const std::string &description);
 
@@ -59,7 +63,7 @@ public:
     static const uint8_t MAX_PAN;
 
 private:
-    std::string myDescription;
+    InternedString myDescription;
     uint8_t myMaxVolume;
     uint8_t myPan;
     Tuning myTuning;
@@ -20,9 +20,13 @@
 #include <algorithm>
 #include <stdexcept>
 
+static_assert(Position::NumSimpleProperties <= 32,
+              "The simple properties must fit in a 32-bit integer");
+
 Position::Position()
     : myPosition(0),
       myDurationType(EighthNote),
+      mySimpleProperties(0),
       myMultiBarRestCount(0)
 {
 }
@@ -30,6 +34,7 @@ Position::Position()
 Position::Position(int position, DurationType duration)
     : myPosition(position),
       myDurationType(duration),
+      mySimpleProperties(0),
       myMultiBarRestCount(0)
 {
 }
@@ -65,7 +70,7 @@ void Position::setDurationType(DurationType type)
 
 bool Position::hasProperty(SimpleProperty property) const
 {
-    return mySimpleProperties.test(property);
+    return (mySimpleProperties & (1u << property)) != 0;
 }
 
 void Position::setProperty(SimpleProperty property, bool set)
@@ -74,37 +79,40 @@ void Position::setProperty(SimpleProperty property, bool set)
     if (set)
     {
         if (property == PickStrokeUp && hasProperty(PickStrokeDown))
-            mySimpleProperties.set(PickStrokeDown, false);
+            mySimpleProperties &= ~(1u << PickStrokeDown);
         if (property == PickStrokeDown && hasProperty(PickStrokeUp))
-            mySimpleProperties.set(PickStrokeUp, false);
+            mySimpleProperties &= ~(1u << PickStrokeUp);
 
         if (property == Vibrato && hasProperty(WideVibrato))
-            mySimpleProperties.set(WideVibrato, false);
+            mySimpleProperties &= ~(1u << WideVibrato);
         if (property == WideVibrato && hasProperty(Vibrato))
-            mySimpleProperties.set(Vibrato, false);
+            mySimpleProperties &= ~(1u << Vibrato);
 
         if (property == ArpeggioUp && hasProperty(ArpeggioDown))
-            mySimpleProperties.set(ArpeggioDown, false);
+            mySimpleProperties &= ~(1u << ArpeggioDown);
         if (property == ArpeggioDown && hasProperty(ArpeggioUp))
-            mySimpleProperties.set(ArpeggioUp, false);
+            mySimpleProperties &= ~(1u << ArpeggioUp);
 
         if (property == Dotted && hasProperty(DoubleDotted))
-            mySimpleProperties.set(DoubleDotted, false);
+            mySimpleProperties &= ~(1u << DoubleDotted);
         if (property == DoubleDotted && hasProperty(Dotted))
-            mySimpleProperties.set(Dotted, false);
+            mySimpleProperties &= ~(1u << Dotted);
 
         if (property == Marcato && hasProperty(Sforzando))
-            mySimpleProperties.set(Sforzando, false);
+            mySimpleProperties &= ~(1u << Sforzando);
         if (property == Sforzando && hasProperty(Marcato))
-            mySimpleProperties.set(Marcato, false);
+            mySimpleProperties &= ~(1u << Marcato);
 
         if (property == TripletFeelFirst && hasProperty(TripletFeelSecond))
-            mySimpleProperties.set(TripletFeelSecond, false);
+            mySimpleProperties &= ~(1u << TripletFeelSecond);
         if (property == TripletFeelSecond && hasProperty(TripletFeelFirst))
-            mySimpleProperties.set(TripletFeelFirst, false);
+            mySimpleProperties &= ~(1u << TripletFeelFirst);
     }
 
-    mySimpleProperties.set(property, set);
+    if (set)
+        mySimpleProperties |= 1u << property;
+    else
+        mySimpleProperties &= ~(1u << property);
 }
 
 bool Position::isRest() const
@@ -19,17 +19,32 @@
 #define SCORE_POSITION_H
 
 #include <algorithm>
+#include "archivetraits.h"
 #include <boost/range/iterator_range_core.hpp>
+#include <boost/version.hpp>
 #include <bitset>
+#include <cstdint>
 #include "fileversion.h"
 #include "note.h"
 #include <vector>
 
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif
+
 class Position
 {
 public:
-    typedef std::vector<Note>::iterator NoteIterator;
-    typedef std::vector<Note>::const_iterator NoteConstIterator;
+#if BOOST_VERSION >= 105800
+    /// Positions with a single note are the most common, so that note is
+    /// stored inline rather than in a separate heap allocation. Chords spill
+    /// onto the heap. More inline slots would make every rest larger.
+    typedef boost::container::small_vector<Note, 1> NoteList;
+#else
+    typedef std::vector<Note> NoteList;
+#endif
+    typedef NoteList::iterator NoteIterator;
+    typedef NoteList::const_iterator NoteConstIterator;
 
     enum DurationType
     {
@@ -121,19 +136,24 @@ public:
 private:
     int myPosition;
     DurationType myDurationType;
-    std::bitset<NumSimpleProperties> mySimpleProperties;
+    uint32_t mySimpleProperties;
     int myMultiBarRestCount;
-    std::vector<Note> myNotes;
+    NoteList myNotes;
 };
 
 template <class Archive>
 void Position::serialize(Archive &ar, const FileVersion /*version*/)
 {
+    std::bitset<NumSimpleProperties> properties(mySimpleProperties);
+
     ar("position", myPosition);
     ar("duration", myDurationType);
-    ar("properties", mySimpleProperties);
+    ar("properties", properties);
     ar("multibar_rest", myMultiBarRestCount);
     ar("notes", myNotes);
+
+    if (ScoreUtils::isLoading<Archive>())
+        mySimpleProperties = static_cast<uint32_t>(properties.to_ulong());
 }
 
 template <class Predicate>
@@ -17,17 +17,80 @@
 
 #include "score.h"
 
+#include "systemloader.h"
+
+#include <algorithm>
+
 const int Score::MIN_LINE_SPACING = 6;
 const int Score::MAX_LINE_SPACING = 14;
 
 Score::Score()
-    : myLineSpacing(9)
+    : myLineSpacing(9),
+      myUnloadedSystemCount(0)
+{
+}
+
+Score::~Score()
 {
 }
 
+Score::Score(const Score &other)
+    : myScoreInfo(other.myScoreInfo),
+      myPlayers(other.myPlayers),
+      myInstruments(other.myInstruments),
+      myLineSpacing(other.myLineSpacing),
+      myViewFilters(other.myViewFilters),
+      myUnloadedSystemCount(0)
+{
+    std::lock_guard<std::mutex> lock(other.myLoaderMutex);
+
+    mySystems = other.mySystems;
+    mySystemLoader = other.mySystemLoader;
+    myUnloadedSystems = other.myUnloadedSystems;
+    myUnloadedSystemCount = other.myUnloadedSystemCount.load();
+}
+
+Score &Score::operator=(const Score &other)
+{
+    if (this == &other)
+        return *this;
+
+    {
+        std::lock(myLoaderMutex, other.myLoaderMutex);
+        std::lock_guard<std::mutex> lock(myLoaderMutex, std::adopt_lock);
+        std::lock_guard<std::mutex> other_lock(other.myLoaderMutex,
+                                               std::adopt_lock);
+
+        mySystems = other.mySystems;
+        mySystemLoader = other.mySystemLoader;
+        myUnloadedSystems = other.myUnloadedSystems;
+        myUnloadedSystemCount = other.myUnloadedSystemCount.load();
+    }
+
+    myScoreInfo = other.myScoreInfo;
+    myPlayers = other.myPlayers;
+    myInstruments = other.myInstruments;
+    myLineSpacing = other.myLineSpacing;
+    myViewFilters = other.myViewFilters;
+
+    return *this;
+}
+
 bool Score::operator==(const Score &other) const
 {
-    return myScoreInfo == other.myScoreInfo && mySystems == other.mySystems &&
+    loadAllSystems();
+    other.loadAllSystems();
+
+    // Systems that are shared between the scores are trivially equal.
+    const bool systemsEqual =
+        mySystems.size() == other.mySystems.size() &&
+        std::equal(mySystems.begin(), mySystems.end(), other.mySystems.begin(),
+                   [](const std::shared_ptr<System> &a,
+                      const std::shared_ptr<System> &b) {
+                       return a == b || *a == *b;
+                   });
+
+    return myScoreInfo == other.myScoreInfo && systemsEqual &&
            myPlayers == other.myPlayers &&
            myInstruments == other.myInstruments &&
            myLineSpacing == other.myLineSpacing &&
@@ -46,25 +109,147 @@ void Score::setScoreInfo(const ScoreInfo &info)
 
 boost::iterator_range<Score::SystemIterator> Score::getSystems()
 {
-    return boost::make_iterator_range(mySystems);
+    return boost::make_iterator_range(SystemIterator(*this, 0),
+                                      SystemIterator(*this, mySystems.size()));
 }
 
 boost::iterator_range<Score::SystemConstIterator> Score::getSystems() const
 {
-    return boost::make_iterator_range(mySystems);
+    return boost::make_iterator_range(
+        SystemConstIterator(*this, 0),
+        SystemConstIterator(*this, mySystems.size()));
 }
 
 void Score::insertSystem(const System &system, int index)
 {
+    std::lock_guard<std::mutex> lock(myLoaderMutex);
+
     if (index < 0)
-        mySystems.push_back(system);
-    else
-        mySystems.insert(mySystems.begin() + index, system);
+        index = static_cast<int>(mySystems.size());
+
+    mySystems.insert(mySystems.begin() + index,
+                     std::make_shared<System>(system));
+
+    if (!myUnloadedSystems.empty())
+        myUnloadedSystems.insert(myUnloadedSystems.begin() + index, -1);
 }
 
 void Score::removeSystem(int index)
 {
+    std::lock_guard<std::mutex> lock(myLoaderMutex);
+
     mySystems.erase(mySystems.begin() + index);
+
+    if (!myUnloadedSystems.empty())
+    {
+        const bool unloaded = myUnloadedSystems[index] >= 0;
+        myUnloadedSystems.erase(myUnloadedSystems.begin() + index);
+
+        if (unloaded && --myUnloadedSystemCount == 0)
+        {
+            myUnloadedSystems.clear();
+            mySystemLoader.reset();
+        }
+    }
+}
+
+void Score::setSystemLoader(std::unique_ptr<SystemLoader> loader)
+{
+    std::lock_guard<std::mutex> lock(myLoaderMutex);
+
+    const int count = loader->getSystemCount();
+    mySystems.clear();
+    for (int i = 0; i < count; ++i)
+        mySystems.push_back(std::make_shared<System>());
+    myUnloadedSystems.resize(count);
+    for (int i = 0; i < count; ++i)
+        myUnloadedSystems[i] = i;
+
+    myUnloadedSystemCount = count;
+    mySystemLoader = std::move(loader);
+}
+
+int Score::getUnloadedSystemCount() const
+{
+    return myUnloadedSystemCount;
+}
+
+bool Score::isSystemLoaded(int index) const
+{
+    if (myUnloadedSystemCount == 0)
+        return true;
+
+    std::lock_guard<std::mutex> lock(myLoaderMutex);
+    return myUnloadedSystems.empty() || myUnloadedSystems[index] < 0;
+}
+
+System &Score::getSystem(size_t index)
+{
+    if (myUnloadedSystemCount > 0)
+        loadSystem(index);
+
+    // Make a private copy of the system before it can be modified.
+    std::shared_ptr<System> &system = mySystems[index];
+    if (system.use_count() > 1)
+        system = std::make_shared<System>(*system);
+
+    return *system;
+}
+
+const System &Score::getSystem(size_t index) const
+{
+    if (myUnloadedSystemCount > 0)
+        loadSystem(index);
+
+    return *mySystems[index];
+}
+
+void Score::loadSystem(size_t index) const
+{
+    std::shared_ptr<const SystemLoader> loader;
+    int loaderIndex;
+    {
+        std::lock_guard<std::mutex> lock(myLoaderMutex);
+
+        // Another thread may have loaded the system in the meantime.
+        if (myUnloadedSystems.empty() || myUnloadedSystems[index] < 0)
+            return;
+
+        loader = mySystemLoader;
+        loaderIndex = myUnloadedSystems[index];
+    }
+
+    // Decompressing and parsing the system is the slow part, so it is done
+    // without holding the lock to allow other systems to be loaded in
+    // parallel. The placeholder may be shared with a copy of the score, so it
+    // is replaced rather than modified.
+    auto system = std::make_shared<System>();
+    loader->loadSystem(loaderIndex, *system);
+
+    std::lock_guard<std::mutex> lock(myLoaderMutex);
+
+    // If another thread loaded the same system first, keep its result.
+    if (myUnloadedSystems.empty() || myUnloadedSystems[index] != loaderIndex ||
+        mySystemLoader != loader)
+    {
+        return;
+    }
+
+    mySystems[index] = std::move(system);
+    myUnloadedSystems[index] = -1;
+
+    // Release the loader's data once everything has been loaded.
+    if (--myUnloadedSystemCount == 0)
+    {
+        myUnloadedSystems.clear();
+        mySystemLoader.reset();
+    }
+}
+
+void Score::loadAllSystems() const
+{
+    for (size_t i = 0; i < mySystems.size() && myUnloadedSystemCount > 0; ++i)
+        loadSystem(i);
 }
 
 boost::iterator_range<Score::PlayerIterator> Score::getPlayers()
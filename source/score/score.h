@@ -18,9 +18,13 @@
 #ifndef SCORE_SCORE_H
 #define SCORE_SCORE_H
 
+#include <atomic>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/range/iterator_range_core.hpp>
 #include "fileversion.h"
 #include "instrument.h"
+#include <memory>
+#include <mutex>
 #include "player.h"
 #include "scoreinfo.h"
 #include "system.h"
@@ -28,12 +32,56 @@
 #include <vector>
 
 class PlayerChange;
+class SystemLoader;
+
+/// Random access iterator over the systems in a score. Systems that have not
+/// been loaded yet are loaded when the iterator is dereferenced.
+template <typename ScoreT, typename SystemT>
+class ScoreSystemIterator
+    : public boost::iterator_facade<ScoreSystemIterator<ScoreT, SystemT>,
+                                    SystemT, boost::random_access_traversal_tag>
+{
+public:
+    ScoreSystemIterator() : myScore(nullptr), myIndex(0)
+    {
+    }
+
+    ScoreSystemIterator(ScoreT &score, std::ptrdiff_t index)
+        : myScore(&score), myIndex(index)
+    {
+    }
+
+private:
+    friend class boost::iterator_core_access;
+
+    SystemT &dereference() const
+    {
+        return myScore->getSystem(myIndex);
+    }
+
+    bool equal(const ScoreSystemIterator &other) const
+    {
+        return myIndex == other.myIndex;
+    }
+
+    void increment() { ++myIndex; }
+    void decrement() { --myIndex; }
+    void advance(std::ptrdiff_t n) { myIndex += n; }
+
+    std::ptrdiff_t distance_to(const ScoreSystemIterator &other) const
+    {
+        return other.myIndex - myIndex;
+    }
+
+    ScoreT *myScore;
+    std::ptrdiff_t myIndex;
+};
 
 class Score
 {
 public:
-    typedef std::vector<System>::iterator SystemIterator;
-    typedef std::vector<System>::const_iterator SystemConstIterator;
+    typedef ScoreSystemIterator<Score, System> SystemIterator;
+    typedef ScoreSystemIterator<const Score, const System> SystemConstIterator;
     typedef std::vector<Player>::iterator PlayerIterator;
     typedef std::vector<Player>::const_iterator PlayerConstIterator;
     typedef std::vector<Instrument>::iterator InstrumentIterator;
@@ -42,13 +90,23 @@ public:
     typedef std::vector<ViewFilter>::const_iterator ViewFilterConstIterator;
 
     Score();
-    Score(const Score &other) = delete;
-    Score &operator=(const Score &other) = delete;
+    ~Score();
+    /// Copying a score is cheap, since the systems are shared with the other
+    /// score until one of the copies modifies them. Systems that have not
+    /// been loaded yet are not loaded by the copy; the copies share the
+    /// loader, and each loads the systems that it accesses.
+    Score(const Score &other);
+    Score &operator=(const Score &other);
     bool operator==(const Score &other) const;
 
     template <class Archive>
     void serialize(Archive &ar, const FileVersion version);
 
+    /// Serializes everything except for the systems, which are stored
+    /// separately in indexed files.
+    template <class Archive>
+    void serializeWithoutSystems(Archive &ar, const FileVersion version);
+
     /// Returns information about the score (e.g. title, author, etc.).
     const ScoreInfo &getScoreInfo() const;
     /// Sets information about the score (e.g. title, author, etc.).
@@ -64,6 +122,14 @@ public:
     /// Removes the specified system from the score.
     void removeSystem(int index);
 
+    /// Replaces the systems in the score with systems that are loaded from
+    /// the loader when they are first accessed.
+    void setSystemLoader(std::unique_ptr<SystemLoader> loader);
+    /// Returns the number of systems that have not been loaded yet.
+    int getUnloadedSystemCount() const;
+    /// Returns whether the specified system has been loaded.
+    bool isSystemLoaded(int index) const;
+
     /// Returns the set of players in the score.
     boost::iterator_range<PlayerIterator> getPlayers();
     /// Returns the set of players in the score.
@@ -105,20 +171,68 @@ public:
     static const int MAX_LINE_SPACING;
 
 private:
+    template <typename ScoreT, typename SystemT>
+    friend class ScoreSystemIterator;
+
+    template <class Archive>
+    void serializeMembers(Archive &ar, const FileVersion version,
+                          bool includeSystems);
+
+    /// Returns the specified system, loading it first if necessary. If the
+    /// system is shared with a copy of the score, this score's copy of the
+    /// system is detached first.
+    System &getSystem(size_t index);
+    const System &getSystem(size_t index) const;
+    void loadSystem(size_t index) const;
+    /// Loads any systems that have not been accessed yet.
+    void loadAllSystems() const;
+
     // TODO - add font settings, chord diagrams, etc.
     ScoreInfo myScoreInfo;
-    std::vector<System> mySystems;
+    /// The systems may be shared with copies of this score, and are
+    /// copy-on-write.
+    mutable std::vector<std::shared_ptr<System>> mySystems;
     std::vector<Player> myPlayers;
     std::vector<Instrument> myInstruments;
     int myLineSpacing; ///< Spacing between tab lines (in pixels).
     std::vector<ViewFilter> myViewFilters;
+
+    /// The loader is shared with copies of the score, and the unloaded
+    /// systems are empty placeholders that are replaced (rather than filled
+    /// in) when loaded, since they may also be shared.
+    mutable std::shared_ptr<const SystemLoader> mySystemLoader;
+    /// For each system, its index in the loader if it has not been loaded
+    /// yet, or -1.
+    mutable std::vector<int> myUnloadedSystems;
+    mutable std::atomic<int> myUnloadedSystemCount;
+    /// Systems may be loaded from multiple threads (e.g. during playback).
+    mutable std::mutex myLoaderMutex;
 };
 
 template <class Archive>
 void Score::serialize(Archive &ar, const FileVersion version)
+{
+    serializeMembers(ar, version, true);
+}
+
+template <class Archive>
+void Score::serializeWithoutSystems(Archive &ar, const FileVersion version)
+{
+    serializeMembers(ar, version, false);
+}
+
+template <class Archive>
+void Score::serializeMembers(Archive &ar, const FileVersion version,
+                             bool includeSystems)
 {
     ar("score_info", myScoreInfo);
-    ar("systems", mySystems);
+
+    if (includeSystems)
+    {
+        loadAllSystems();
+        ar("systems", mySystems);
+    }
+
     ar("players", myPlayers);
     ar("instruments", myInstruments);
     ar("line_spacing", myLineSpacing);
@@ -21,6 +21,7 @@
 #include <boost/date_time/gregorian/greg_date.hpp>
 #include <boost/optional.hpp>
 #include "fileversion.h"
+#include "internedstring.h"
 #include <string>
 
 class SongData
@@ -60,7 +61,7 @@ public:
 
     private:
         ReleaseType myReleaseType;
-        std::string myTitle;
+        InternedString myTitle;
         int myYear;
         bool myIsLive;
     };
@@ -83,7 +84,7 @@ public:
         bool isLive() const;
 
     private:
-        std::string myTitle;
+        InternedString myTitle;
         bool myIsLive;
     };
 
@@ -106,7 +107,7 @@ public:
         const boost::gregorian::date &getDate() const;
 
     private:
-        std::string myTitle;
+        InternedString myTitle;
         boost::gregorian::date myDate;
     };
 
@@ -128,8 +129,8 @@ public:
         const std::string &getLyricist() const;
 
     private:
-        std::string myComposer;
-        std::string myLyricist;
+        InternedString myComposer;
+        InternedString myLyricist;
     };
 
     SongData();
@@ -180,17 +181,17 @@ public:
     const std::string &getPerformanceNotes() const;
 
 private:
-    std::string myTitle;
-    std::string myArtist;
+    InternedString myTitle;
+    InternedString myArtist;
     boost::optional<AudioReleaseInfo> myAudioReleaseInfo;
     boost::optional<VideoReleaseInfo> myVideoReleaseInfo;
     boost::optional<BootlegInfo> myBootlegReleaseInfo;
     boost::optional<AuthorInfo> myAuthorInfo;
-    std::string myArranger;
-    std::string myTranscriber;
-    std::string myCopyright;
-    std::string myLyrics;
-    std::string myPerformanceNotes;
+    InternedString myArranger;
+    InternedString myTranscriber;
+    InternedString myCopyright;
+    InternedString myLyrics;
+    InternedString myPerformanceNotes;
     // TODO - add performance notes and transcriber credits for each view?
 };
 
@@ -272,13 +273,13 @@ public:
     const std::string &getCopyright() const;
 
 private:
-    std::string myTitle;
-    std::string mySubtitle;
+    InternedString myTitle;
+    InternedString mySubtitle;
     MusicStyle myMusicStyle;
     DifficultyLevel myDifficultyLevel;
-    std::string myAuthor;
-    std::string myNotes;
-    std::string myCopyright;
+    InternedString myAuthor;
+    InternedString myNotes;
+    InternedString myCopyright;
 };
 
 template <class Archive>
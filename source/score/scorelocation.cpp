@@ -79,6 +79,7 @@ const Position *ScoreLocation::getPosition() const
 
 Position *ScoreLocation::getPosition()
 {
+    prepareVoiceForWrite();
     return const_cast<Position *>(
                 const_cast<const ScoreLocation &>(*this).getPosition());
 }
@@ -146,6 +147,7 @@ bool ScoreLocation::hasSelection() const
 std::vector<Position *> ScoreLocation::getSelectedPositions()
 {
     // Avoid duplicate logic between const and non-const versions.
+    prepareVoiceForWrite();
     auto positions = const_cast<const ScoreLocation *>(this)->getSelectedPositions();
     std::vector<Position *> nc_positions;
     for (const Position *pos : positions)
@@ -214,6 +216,15 @@ const System &ScoreLocation::getSystem() const
     return myScore.getSystems()[mySystemIndex];
 }
 
+void ScoreLocation::prepareVoiceForWrite()
+{
+    // Accessing the voice's positions through a non-const reference detaches
+    // the system if it is shared with another copy of the score, and discards
+    // the voice's cached durations.
+    if (myWriteableScore)
+        getVoice().getPositions();
+}
+
 System &ScoreLocation::getSystem()
 {
     if (!myWriteableScore)
@@ -268,6 +279,7 @@ const Note *ScoreLocation::getNote() const
 
 Note *ScoreLocation::getNote()
 {
+    prepareVoiceForWrite();
     return const_cast<Note *>(
                 const_cast<const ScoreLocation &>(*this).getNote());
 }
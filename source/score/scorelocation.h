@@ -88,6 +88,9 @@ public:
     std::vector<Note *> getSelectedNotes();
 
 private:
+    /// Called before returning a non-const pointer into the current voice.
+    void prepareVoiceForWrite();
+
     const Score &myScore;
     Score *myWriteableScore;
 
@@ -23,9 +23,12 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
+#include <boost/version.hpp>
 #include <bitset>
 #include "fileversion.h"
+#include "internedstring.h"
 #include <map>
+#include <memory>
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
 #include <stack>
@@ -33,6 +36,10 @@
 #include <util/rapidjson_iostreams.h>
 #include <vector>
 
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif
+
 namespace ScoreUtils
 {
 class InputArchive
@@ -120,10 +127,19 @@ private:
     inline void read(uint8_t &val);
     inline void read(bool &val);
     inline void read(std::string &str);
+    inline void read(InternedString &str);
 
     template <typename T>
     void read(std::vector<T> &vec);
 
+#if BOOST_VERSION >= 105800
+    template <typename T, size_t N>
+    void read(boost::container::small_vector<T, N> &vec);
+#endif
+
+    template <typename Container>
+    void readArray(Container &container);
+
     template <typename K, typename V, typename C>
     void read(std::map<K, V, C> &map);
 
@@ -136,6 +152,9 @@ private:
     template <typename T>
     void read(boost::optional<T> &val);
 
+    template <typename T>
+    void read(std::shared_ptr<T> &ptr);
+
     inline void read(boost::gregorian::date &date);
 
     template <typename T>
@@ -193,10 +212,19 @@ private:
     inline void write(unsigned int val);
     inline void write(bool val);
     inline void write(const std::string &str);
+    inline void write(const InternedString &str);
 
     template <typename T>
     void write(const std::vector<T> &vec);
 
+#if BOOST_VERSION >= 105800
+    template <typename T, size_t N>
+    void write(const boost::container::small_vector<T, N> &vec);
+#endif
+
+    template <typename Container>
+    void writeArray(const Container &container);
+
     template <typename K, typename V, typename C>
     void write(const std::map<K, V, C> &map);
 
@@ -209,6 +237,9 @@ private:
     template <typename T>
     void write(const boost::optional<T> &val);
 
+    template <typename T>
+    void write(const std::shared_ptr<T> &ptr);
+
     inline void write(const boost::gregorian::date &date);
 
     template <typename T>
@@ -273,16 +304,35 @@ void InputArchive::read(std::string &str)
     str = value().GetString();
 }
 
+void InputArchive::read(InternedString &str)
+{
+    str = value().GetString();
+}
+
 template <typename T>
 void InputArchive::read(std::vector<T> &vec)
+{
+    readArray(vec);
+}
+
+#if BOOST_VERSION >= 105800
+template <typename T, size_t N>
+void InputArchive::read(boost::container::small_vector<T, N> &vec)
+{
+    readArray(vec);
+}
+#endif
+
+template <typename Container>
+void InputArchive::readArray(Container &container)
 {
     auto size = value().Size();
     myIterators.push(value().Begin());
 
-    vec.resize(size);
+    container.resize(size);
     for (unsigned int i = 0; i < size; ++i)
     {
-        read(vec[i]);
+        read(container[i]);
         advance();
     }
 
@@ -342,6 +392,13 @@ void InputArchive::read(boost::optional<T> &val)
     }
 }
 
+template <typename T>
+void InputArchive::read(std::shared_ptr<T> &ptr)
+{
+    ptr = std::make_shared<T>();
+    read(*ptr);
+}
+
 void InputArchive::read(boost::gregorian::date &date)
 {
     std::string date_str;
@@ -370,11 +427,30 @@ void OutputArchive::write(const std::string &str)
                     static_cast<rapidjson::SizeType>(str.length()));
 }
 
+void OutputArchive::write(const InternedString &str)
+{
+    write(str.str());
+}
+
 template <typename T>
 void OutputArchive::write(const std::vector<T> &vec)
+{
+    writeArray(vec);
+}
+
+#if BOOST_VERSION >= 105800
+template <typename T, size_t N>
+void OutputArchive::write(const boost::container::small_vector<T, N> &vec)
+{
+    writeArray(vec);
+}
+#endif
+
+template <typename Container>
+void OutputArchive::writeArray(const Container &container)
 {
     myStream.StartArray();
-    for (const T &obj : vec)
+    for (const auto &obj : container)
         write(obj);
     myStream.EndArray();
 }
@@ -416,6 +492,12 @@ void OutputArchive::write(const boost::optional<T> &val)
         myStream.Null();
 }
 
+template <typename T>
+void OutputArchive::write(const std::shared_ptr<T> &ptr)
+{
+    write(*ptr);
+}
+
 void OutputArchive::write(const boost::gregorian::date &date)
 {
     write(boost::gregorian::to_iso_string(date));
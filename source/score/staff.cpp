@@ -42,6 +42,7 @@ Staff::ClefType Staff::getClefType() const
 
 void Staff::setClefType(ClefType type)
 {
+    myContentHash.reset();
     myClefType = type;
 }
 
@@ -52,6 +53,7 @@ int Staff::getStringCount() const
 
 void Staff::setStringCount(int count)
 {
+    myContentHash.reset();
     myStringCount = count;
 
     // Clean up notes / positions that are no longer valid.
@@ -82,6 +84,7 @@ boost::iterator_range<Staff::VoiceConstIterator> Staff::getVoices() const
 
 boost::iterator_range<Staff::DynamicIterator> Staff::getDynamics()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myDynamics);
 }
 
@@ -92,10 +95,30 @@ boost::iterator_range<Staff::DynamicConstIterator> Staff::getDynamics() const
 
 void Staff::insertDynamic(const Dynamic &dynamic)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myDynamics, dynamic);
 }
 
 void Staff::removeDynamic(const Dynamic &dynamic)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myDynamics, dynamic);
 }
+
+uint64_t Staff::getContentHash() const
+{
+    const uint64_t hash = myContentHash.get([this]() {
+        ScoreUtils::ContentHasher hasher;
+        hasher.add(myClefType);
+        hasher.add(myStringCount);
+        hasher.addRange(myDynamics);
+        return hasher.getHash();
+    });
+
+    // Voices can be modified through a reference without accessing the staff
+    // again, so their hashes are always combined here.
+    ScoreUtils::ContentHasher hasher;
+    hasher.add(hash);
+    hasher.addRange(myVoices);
+    return hasher.getHash();
+}
@@ -19,7 +19,9 @@
 #define SCORE_STAFF_H
 
 #include <array>
+#include "archivetraits.h"
 #include <boost/range/iterator_range_core.hpp>
+#include "contenthash.h"
 #include "dynamic.h"
 #include "fileversion.h"
 #include <vector>
@@ -79,16 +81,27 @@ public:
     /// Removes the specified dynamic from the staff.
     void removeDynamic(const Dynamic &dynamic);
 
+    /// Returns a hash of the staff's contents. The hash of the clef, strings
+    /// and dynamics is cached until one of the staff's non-const methods is
+    /// called, and is combined with the voices' cached hashes (see
+    /// Voice::getContentHash()). A dynamic that is modified through a
+    /// reference obtained before the hash was computed is not detected.
+    uint64_t getContentHash() const;
+
 private:
     ClefType myClefType;
     int myStringCount;
     std::array<Voice, NUM_VOICES> myVoices;
     std::vector<Dynamic> myDynamics;
+    ScoreUtils::CachedContentHash myContentHash;
 };
 
 template <class Archive>
 void Staff::serialize(Archive &ar, const FileVersion version)
 {
+    if (ScoreUtils::isLoading<Archive>())
+        myContentHash.reset();
+
     if (version < FileVersion::VIEW_FILTERS)
     {
         int view_type = 0;
@@ -54,21 +54,25 @@ boost::iterator_range<System::StaffConstIterator> System::getStaves() const
 
 void System::insertStaff(const Staff &staff)
 {
+    myContentHash.reset();
     myStaves.push_back(staff);
 }
 
 void System::insertStaff(const Staff &staff, int index)
 {
+    myContentHash.reset();
     myStaves.insert(myStaves.begin() + index, staff);
 }
 
 void System::removeStaff(int index)
 {
+    myContentHash.reset();
     myStaves.erase(myStaves.begin() + index);
 }
 
 boost::iterator_range<System::BarlineIterator> System::getBarlines()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myBarlines);
 }
 
@@ -79,6 +83,7 @@ boost::iterator_range<System::BarlineConstIterator> System::getBarlines() const
 
 void System::insertBarline(const Barline &barline)
 {
+    myContentHash.reset();
     // Ensure that the end bar remains the end bar.
     myBarlines.back().setPosition(
         std::max(myBarlines.back().getPosition(), barline.getPosition() + 1));
@@ -87,6 +92,7 @@ void System::insertBarline(const Barline &barline)
 
 void System::removeBarline(const Barline &barline)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myBarlines, barline);
 }
 
@@ -114,6 +120,7 @@ const Barline *System::getNextBarline(int position) const
 
 Barline *System::getNextBarline(int position)
 {
+    myContentHash.reset();
     for (Barline &barline : myBarlines)
     {
         if (barline.getPosition() > position)
@@ -125,6 +132,7 @@ Barline *System::getNextBarline(int position)
 
 boost::iterator_range<System::TempoMarkerIterator> System::getTempoMarkers()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myTempoMarkers);
 }
 
@@ -135,16 +143,19 @@ boost::iterator_range<System::TempoMarkerConstIterator> System::getTempoMarkers(
 
 void System::insertTempoMarker(const TempoMarker &marker)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myTempoMarkers, marker);
 }
 
 void System::removeTempoMarker(const TempoMarker &marker)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myTempoMarkers, marker);
 }
 
 boost::iterator_range<System::AlternateEndingIterator> System::getAlternateEndings()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myAlternateEndings);
 }
 
@@ -155,16 +166,19 @@ boost::iterator_range<System::AlternateEndingConstIterator> System::getAlternate
 
 void System::insertAlternateEnding(const AlternateEnding &ending)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myAlternateEndings, ending);
 }
 
 void System::removeAlternateEnding(const AlternateEnding &ending)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myAlternateEndings, ending);
 }
 
 boost::iterator_range<System::DirectionIterator> System::getDirections()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myDirections);
 }
 
@@ -175,16 +189,19 @@ boost::iterator_range<System::DirectionConstIterator> System::getDirections() co
 
 void System::insertDirection(const Direction &direction)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myDirections, direction);
 }
 
 void System::removeDirection(const Direction &direction)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myDirections, direction);
 }
 
 boost::iterator_range<System::PlayerChangeIterator> System::getPlayerChanges()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myPlayerChanges);
 }
 
@@ -195,16 +212,19 @@ boost::iterator_range<System::PlayerChangeConstIterator> System::getPlayerChange
 
 void System::insertPlayerChange(const PlayerChange &change)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myPlayerChanges, change);
 }
 
 void System::removePlayerChange(const PlayerChange &change)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myPlayerChanges, change);
 }
 
 boost::iterator_range<System::ChordTextIterator> System::getChords()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myChords);
 }
 
@@ -215,16 +235,19 @@ boost::iterator_range<System::ChordTextConstIterator> System::getChords() const
 
 void System::insertChord(const ChordText &chord)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myChords, chord);
 }
 
 void System::removeChord(const ChordText &chord)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myChords, chord);
 }
 
 boost::iterator_range<System::TextItemIterator> System::getTextItems()
 {
+    myContentHash.reset();
     return boost::make_iterator_range(myTextItems);
 }
 
@@ -235,23 +258,59 @@ boost::iterator_range<System::TextItemConstIterator> System::getTextItems() cons
 
 void System::insertTextItem(const TextItem &text)
 {
+    myContentHash.reset();
     ScoreUtils::insertObject(myTextItems, text);
 }
 
 void System::removeTextItem(const TextItem &text)
 {
+    myContentHash.reset();
     ScoreUtils::removeObject(myTextItems, text);
 }
 
+uint64_t System::getContentHash() const
+{
+    const uint64_t hash = myContentHash.get([this]() {
+        ScoreUtils::ContentHasher hasher;
+        hasher.addRange(myBarlines);
+        hasher.addRange(myTempoMarkers);
+        hasher.addRange(myAlternateEndings);
+        hasher.addRange(myDirections);
+
+        // The active players are only looked up for the system's staves.
+        hasher.add(myPlayerChanges.size());
+        for (const PlayerChange &change : myPlayerChanges)
+        {
+            hasher.add(change.getPosition());
+            for (size_t i = 0; i < myStaves.size(); ++i)
+                hasher.addRange(change.getActivePlayers(static_cast<int>(i)));
+        }
+
+        hasher.addRange(myChords);
+        hasher.addRange(myTextItems);
+        return hasher.getHash();
+    });
+
+    // Staves can be modified through a reference without accessing the
+    // system again, so their hashes are always combined here.
+    ScoreUtils::ContentHasher hasher;
+    hasher.add(hash);
+    hasher.addRange(myStaves);
+    return hasher.getHash();
+}
+
 template <typename T>
 static void shift(const T &range, int position,
                   int offset)
 {
-    for (auto &obj : range)
-    {
-        if (obj.getPosition() >= position)
-            obj.setPosition(obj.getPosition() + offset);
-    }
+    // The objects are sorted by position, so only the objects after the
+    // first match need to be visited.
+    auto it = std::lower_bound(range.begin(), range.end(), position,
+                               [](const typename T::value_type &obj,
+                                  int pos) { return obj.getPosition() < pos; });
+
+    for (; it != range.end(); ++it)
+        it->setPosition(it->getPosition() + offset);
 }
 
 void SystemUtils::shift(System &system, int position, int offset)
@@ -278,13 +337,3 @@ void SystemUtils::shift(System &system, int position, int offset)
         }
     }
 }
-
-void SystemUtils::shiftForward(System &system, int position)
-{
-    shift(system, position, 1);
-}
-
-void SystemUtils::shiftBackward(System &system, int position)
-{
-    shift(system, position, -1);
-}
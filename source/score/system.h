@@ -19,9 +19,11 @@
 #define SCORE_SYSTEM_H
 
 #include "alternateending.h"
+#include "archivetraits.h"
 #include "barline.h"
 #include <boost/range/iterator_range_core.hpp>
 #include "chordtext.h"
+#include "contenthash.h"
 #include "direction.h"
 #include "fileversion.h"
 #include "playerchange.h"
@@ -144,6 +146,16 @@ public:
     /// Removes the specified text item from the system.
     void removeTextItem(const TextItem &text);
 
+    /// Returns a hash of the system's contents, which can be used to detect
+    /// whether the system has changed (e.g. as the key for a cache).
+    /// The hash of the barlines, tempo markers, etc. is cached until one of
+    /// the system's non-const methods is called, and is combined with the
+    /// staves' hashes (see Staff::getContentHash()). As with the staves and
+    /// voices, an item that is modified through a reference obtained before
+    /// the hash was computed is not detected, so edits must look up the item
+    /// again. Debug builds check for this.
+    uint64_t getContentHash() const;
+
 private:
     std::vector<Staff> myStaves;
     /// List of the barlines in the system. This will always contain at least
@@ -155,11 +167,15 @@ private:
     std::vector<PlayerChange> myPlayerChanges;
     std::vector<ChordText> myChords;
     std::vector<TextItem> myTextItems;
+    ScoreUtils::CachedContentHash myContentHash;
 };
 
 template <class Archive>
 void System::serialize(Archive &ar, const FileVersion version)
 {
+    if (ScoreUtils::isLoading<Archive>())
+        myContentHash.reset();
+
     ar("staves", myStaves);
     ar("barlines", myBarlines);
     ar("tempo_markers", myTempoMarkers);
@@ -173,11 +189,8 @@ void System::serialize(Archive &ar, const FileVersion version)
 
 namespace SystemUtils {
 
-/// Shifts everything forward starting from the given position.
-void shiftForward(System &system, int position);
-/// Shifts everything backward starting from the given position.
-void shiftBackward(System &system, int position);
-/// Shifts everything by the given offset.
+/// Shifts everything at or after the given position by the offset, in a
+/// single pass over the system.
 void shift(System &system, int position, int offset);
 
 }
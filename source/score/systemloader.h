@@ -0,0 +1,39 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCORE_SYSTEMLOADER_H
+#define SCORE_SYSTEMLOADER_H
+
+class System;
+
+/// Loads the systems of a score on demand, e.g. from an indexed file.
+/// @see Score::setSystemLoader()
+class SystemLoader
+{
+public:
+    virtual ~SystemLoader() {}
+
+    /// Returns the number of systems that can be loaded.
+    virtual int getSystemCount() const = 0;
+
+    /// Loads the system with the given index. This may be called from
+    /// several threads at once.
+    /// @throws std::exception if the system could not be read.
+    virtual void loadSystem(int index, System &system) const = 0;
+};
+
+#endif
@@ -19,6 +19,7 @@
 #define SCORE_TEXTITEM_H
 
 #include "fileversion.h"
+#include "internedstring.h"
 #include <string>
 
 class TextItem
@@ -40,7 +41,7 @@ public:
 
 private:
     int myPosition;
-    std::string myContents;
+    InternedString myContents;
 };
 
 template <class Archive>
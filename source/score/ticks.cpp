@@ -0,0 +1,51 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "ticks.h"
+
+namespace Ticks
+{
+static int64_t gcd(int64_t a, int64_t b)
+{
+    while (b != 0)
+    {
+        const int64_t r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return a < 0 ? -a : a;
+}
+
+int64_t fromRational(const boost::rational<int> &quarters)
+{
+    return PER_QUARTER * quarters.numerator() / quarters.denominator();
+}
+
+boost::rational<int> toRational(int64_t ticks)
+{
+    // Reduce the fraction before narrowing it to an int.
+    const int64_t divisor = gcd(ticks, PER_QUARTER);
+    return boost::rational<int>(static_cast<int>(ticks / divisor),
+                                static_cast<int>(PER_QUARTER / divisor));
+}
+
+int64_t convert(int64_t ticks, int ticks_per_quarter)
+{
+    return ticks * ticks_per_quarter / PER_QUARTER;
+}
+}
@@ -0,0 +1,44 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_TICKS_H
+#define SCORE_TICKS_H
+
+#include <boost/rational.hpp>
+#include <cstdint>
+
+/// Durations within the score are measured as a whole number of ticks, which
+/// avoids the cost of normalizing a boost::rational after every operation.
+namespace Ticks
+{
+/// The number of ticks in a quarter note. This is divisible by the length of
+/// every note (down to a double dotted 64th note) combined with any irregular
+/// grouping of up to 16 notes, so these durations are exact.
+const int64_t PER_QUARTER = 64 * 720720;
+
+/// Converts a number of quarter notes (e.g. 1/2 for an eighth note) to ticks.
+int64_t fromRational(const boost::rational<int> &quarters);
+
+/// Converts a number of ticks to quarter notes.
+boost::rational<int> toRational(int64_t ticks);
+
+/// Converts a number of ticks to a different resolution (e.g. the number of
+/// ticks per beat in a MIDI file), rounding down.
+int64_t convert(int64_t ticks, int ticks_per_quarter);
+}
+
+#endif
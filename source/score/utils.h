@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/iterator_range_core.hpp>
+#include <iterator>
+#include <vector>
 
 namespace ScoreUtils {
 
@@ -104,6 +106,30 @@ namespace ScoreUtils {
             std::sort(objects.begin(), objects.end(), OrderByPosition<T>());
     }
 
+    /// Inserts a batch of objects. This is cheaper than calling
+    /// insertObject() for each object, since the new objects are sorted once
+    /// and then merged with the existing objects.
+    template <typename T>
+    void insertObjects(std::vector<T> &objects, std::vector<T> newObjects)
+    {
+        const OrderByPosition<T> order;
+        if (!std::is_sorted(newObjects.begin(), newObjects.end(), order))
+            std::stable_sort(newObjects.begin(), newObjects.end(), order);
+
+        const size_t oldSize = objects.size();
+        objects.insert(objects.end(),
+                       std::make_move_iterator(newObjects.begin()),
+                       std::make_move_iterator(newObjects.end()));
+
+        // Avoid merging if the new objects are all after the existing objects.
+        const auto middle = objects.begin() + oldSize;
+        if (oldSize > 0 && middle != objects.end() &&
+            order(*middle, *(middle - 1)))
+        {
+            std::inplace_merge(objects.begin(), middle, objects.end(), order);
+        }
+    }
+
     template <typename T>
     void removeObject(std::vector<T> &objects, const T &obj)
     {
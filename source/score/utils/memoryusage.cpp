@@ -0,0 +1,147 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "memoryusage.h"
+
+#include <boost/range/size.hpp>
+#include <memory>
+#include <score/score.h>
+
+namespace
+{
+/// Returns the number of bytes used by the objects in the range, not
+/// including any heap storage that they own.
+template <typename Range>
+size_t rangeSize(const Range &range)
+{
+    typedef typename boost::range_value<Range>::type T;
+    return boost::size(range) * sizeof(T);
+}
+
+void measurePosition(const Position &pos, ScoreUtils::MemoryUsage &usage)
+{
+    auto notes = pos.getNotes();
+    const size_t notesSize = rangeSize(notes);
+    usage.myNotes += notesSize;
+    usage.myPositions += sizeof(Position);
+
+    // Notes may be stored inside the position, in which case they are
+    // already included in sizeof(Position).
+    if (!notes.empty())
+    {
+        const char *begin = reinterpret_cast<const char *>(&pos);
+        const char *data = reinterpret_cast<const char *>(&notes.front());
+        if (data >= begin && data < begin + sizeof(Position))
+            usage.myPositions -= notesSize;
+    }
+
+    // Bends, artificial harmonics, etc are stored separately from the note.
+    for (const Note &note : notes)
+    {
+        if (note.hasBend() || note.hasArtificialHarmonic() ||
+            note.hasLeftHandFingering())
+        {
+            usage.myNotes += sizeof(boost::optional<Bend>) +
+                             sizeof(boost::optional<ArtificialHarmonic>) +
+                             sizeof(boost::optional<LeftHandFingering>);
+        }
+    }
+}
+}
+
+namespace ScoreUtils
+{
+MemoryUsage::MemoryUsage()
+    : myScore(0),
+      mySystems(0),
+      myStaves(0),
+      myVoices(0),
+      myPositions(0),
+      myNotes(0)
+{
+}
+
+MemoryUsage &MemoryUsage::operator+=(const MemoryUsage &other)
+{
+    myScore += other.myScore;
+    mySystems += other.mySystems;
+    myStaves += other.myStaves;
+    myVoices += other.myVoices;
+    myPositions += other.myPositions;
+    myNotes += other.myNotes;
+    return *this;
+}
+
+size_t MemoryUsage::getTotal() const
+{
+    return myScore + mySystems + myStaves + myVoices + myPositions + myNotes;
+}
+
+MemoryUsage measureMemory(const Score &score)
+{
+    MemoryUsage usage;
+    usage.myScore += sizeof(Score);
+    usage.myScore += rangeSize(score.getPlayers());
+    usage.myScore += rangeSize(score.getInstruments());
+    usage.myScore += rangeSize(score.getViewFilters());
+
+    const int numSystems = static_cast<int>(score.getSystems().size());
+    usage.myScore += numSystems * sizeof(std::shared_ptr<System>);
+
+    for (int i = 0; i < numSystems; ++i)
+    {
+        if (score.isSystemLoaded(i))
+            usage += measureMemory(score.getSystems()[i]);
+    }
+
+    return usage;
+}
+
+MemoryUsage measureMemory(const System &system)
+{
+    MemoryUsage usage;
+    usage.mySystems += sizeof(System);
+    usage.mySystems += rangeSize(system.getBarlines());
+    usage.mySystems += rangeSize(system.getTempoMarkers());
+    usage.mySystems += rangeSize(system.getAlternateEndings());
+    usage.mySystems += rangeSize(system.getDirections());
+    usage.mySystems += rangeSize(system.getPlayerChanges());
+    usage.mySystems += rangeSize(system.getChords());
+    usage.mySystems += rangeSize(system.getTextItems());
+
+    usage.myStaves += rangeSize(system.getStaves());
+    for (const Staff &staff : system.getStaves())
+    {
+        usage.myStaves += rangeSize(staff.getDynamics());
+
+        for (const Voice &voice : staff.getVoices())
+        {
+            usage.myVoices += rangeSize(voice.getIrregularGroupings());
+
+            for (const Position &pos : voice.getPositions())
+                measurePosition(pos, usage);
+        }
+    }
+
+    return usage;
+}
+
+size_t estimateMemoryUsage(const System &system)
+{
+    return measureMemory(system).getTotal();
+}
+}
@@ -0,0 +1,65 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_UTILS_MEMORYUSAGE_H
+#define SCORE_UTILS_MEMORYUSAGE_H
+
+#include <cstddef>
+
+class Score;
+class System;
+
+namespace ScoreUtils
+{
+/// A breakdown of the memory used by a score, in bytes.
+struct MemoryUsage
+{
+    MemoryUsage();
+
+    MemoryUsage &operator+=(const MemoryUsage &other);
+
+    /// Returns the total number of bytes.
+    size_t getTotal() const;
+
+    /// The score itself, and its players, instruments, view filters, etc.
+    size_t myScore;
+    /// The systems, and their barlines, tempo markers, text items, etc.
+    size_t mySystems;
+    /// The staves and their dynamics. Each staff also includes its voices.
+    size_t myStaves;
+    /// Irregular groupings and any other storage owned by the voices.
+    size_t myVoices;
+    /// The positions, not including their notes.
+    size_t myPositions;
+    /// The notes, including any bends, artificial harmonics, etc.
+    size_t myNotes;
+};
+
+/// Measures the memory used by the score. Systems that have not been loaded
+/// yet are not included (or loaded).
+MemoryUsage measureMemory(const Score &score);
+
+/// Measures the memory used by the system, including its staves, positions,
+/// notes, etc.
+MemoryUsage measureMemory(const System &system);
+
+/// Returns an estimate of the number of bytes used by the system, including
+/// its staves, positions, notes, etc.
+size_t estimateMemoryUsage(const System &system);
+}
+
+#endif
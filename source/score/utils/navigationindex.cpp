@@ -0,0 +1,99 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "navigationindex.h"
+
+#include <algorithm>
+#include <score/score.h>
+
+NavigationIndex::RehearsalSignEntry::RehearsalSignEntry(
+    const SystemLocation &location, const std::string &letters,
+    const std::string &description)
+    : myLocation(location), myLetters(letters), myDescription(description)
+{
+}
+
+NavigationIndex::NavigationIndex(const Score &score)
+{
+    int system_index = 0;
+    for (const System &system : score.getSystems())
+    {
+        mySystemFirstBars.push_back(static_cast<int>(myBarLocations.size()));
+
+        for (const Barline &barline : system.getBarlines())
+        {
+            // Index all barlines except for the end bar.
+            if (&barline != &system.getBarlines().back())
+            {
+                myBarLocations.emplace_back(system_index,
+                                            barline.getPosition());
+            }
+
+            if (barline.hasRehearsalSign())
+            {
+                const RehearsalSign &sign = barline.getRehearsalSign();
+                myRehearsalSignLetters.emplace(
+                    sign.getLetters(),
+                    static_cast<int>(myRehearsalSigns.size()));
+                myRehearsalSigns.emplace_back(
+                    SystemLocation(system_index, barline.getPosition()),
+                    sign.getLetters(), sign.getDescription());
+            }
+        }
+
+        ++system_index;
+    }
+}
+
+int NavigationIndex::getBarCount() const
+{
+    return static_cast<int>(myBarLocations.size());
+}
+
+const SystemLocation &NavigationIndex::getBarLocation(int barNumber) const
+{
+    return myBarLocations.at(barNumber - 1);
+}
+
+int NavigationIndex::findBarNumber(const SystemLocation &location) const
+{
+    const int system = location.getSystem();
+    const int first = mySystemFirstBars.at(system);
+    const int last = system + 1 < static_cast<int>(mySystemFirstBars.size())
+                         ? mySystemFirstBars[system + 1]
+                         : getBarCount();
+
+    // Find the last bar in the system that starts at or before the location.
+    auto it = std::upper_bound(myBarLocations.begin() + first,
+                               myBarLocations.begin() + last, location);
+    return std::max(first, static_cast<int>(it - myBarLocations.begin()) - 1) +
+           1;
+}
+
+const std::vector<NavigationIndex::RehearsalSignEntry> &
+NavigationIndex::getRehearsalSigns() const
+{
+    return myRehearsalSigns;
+}
+
+const NavigationIndex::RehearsalSignEntry *NavigationIndex::findRehearsalSign(
+    const std::string &letters) const
+{
+    auto it = myRehearsalSignLetters.find(letters);
+    return it != myRehearsalSignLetters.end() ? &myRehearsalSigns[it->second]
+                                              : nullptr;
+}
@@ -0,0 +1,71 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_UTILS_NAVIGATIONINDEX_H
+#define SCORE_UTILS_NAVIGATIONINDEX_H
+
+#include <score/systemlocation.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Score;
+
+/// Indexes the bars and rehearsal signs in a score, for quickly jumping to a
+/// bar number or rehearsal sign. This must be rebuilt after the score is
+/// modified.
+class NavigationIndex
+{
+public:
+    struct RehearsalSignEntry
+    {
+        RehearsalSignEntry(const SystemLocation &location,
+                           const std::string &letters,
+                           const std::string &description);
+
+        SystemLocation myLocation;
+        std::string myLetters;
+        std::string myDescription;
+    };
+
+    explicit NavigationIndex(const Score &score);
+
+    /// Returns the number of bars in the score.
+    int getBarCount() const;
+    /// Returns the location of the start of a bar, where bars are numbered
+    /// from 1 in the order that they appear in the score.
+    const SystemLocation &getBarLocation(int barNumber) const;
+    /// Returns the number of the bar that contains the location.
+    int findBarNumber(const SystemLocation &location) const;
+
+    /// Returns the rehearsal signs in the order that they appear in the score.
+    const std::vector<RehearsalSignEntry> &getRehearsalSigns() const;
+    /// Returns the first rehearsal sign with the given letters, or null if
+    /// there is no such rehearsal sign.
+    const RehearsalSignEntry *findRehearsalSign(
+        const std::string &letters) const;
+
+private:
+    std::vector<SystemLocation> myBarLocations;
+    /// The index in myBarLocations of each system's first bar.
+    std::vector<int> mySystemFirstBars;
+    std::vector<RehearsalSignEntry> myRehearsalSigns;
+    /// Maps the letters of a rehearsal sign to its index in myRehearsalSigns.
+    std::unordered_map<std::string, int> myRehearsalSignLetters;
+};
+
+#endif
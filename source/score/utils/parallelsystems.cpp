@@ -0,0 +1,159 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "parallelsystems.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <score/score.h>
+#include <thread>
+#include <vector>
+
+ScoreUtils::ParallelOptions::ParallelOptions(unsigned int numThreads)
+    : myNumThreads(std::max(1u, numThreads))
+{
+}
+
+ScoreUtils::ParallelOptions ScoreUtils::ParallelOptions::allThreads()
+{
+    return ParallelOptions(std::thread::hardware_concurrency());
+}
+
+template <typename SystemT>
+static bool forEachSystemImpl(
+    const std::vector<SystemT *> &systems,
+    const std::function<void(int, SystemT &)> &fn,
+    const ScoreUtils::ParallelOptions &options)
+{
+    const int numSystems = static_cast<int>(systems.size());
+    const unsigned int numThreads = std::max(
+        1u, std::min<unsigned int>(options.myNumThreads, systems.size()));
+
+    std::atomic<int> nextSystem(0);
+    std::atomic<bool> cancelled(false);
+
+    // The remaining state is protected by the mutex.
+    std::mutex mutex;
+    std::condition_variable progressChanged;
+    int numCompleted = 0;
+    int numRunning = 0;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        int i;
+        while (!cancelled && (i = nextSystem++) < numSystems)
+        {
+            try
+            {
+                fn(i, *systems[i]);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+                cancelled = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++numCompleted;
+            }
+            progressChanged.notify_one();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --numRunning;
+        }
+        progressChanged.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    numRunning = numThreads;
+
+    if (!options.myProgress)
+    {
+        for (unsigned int i = 1; i < numThreads; ++i)
+            threads.emplace_back(worker);
+
+        // Use the current thread as one of the workers.
+        worker();
+    }
+    else
+    {
+        for (unsigned int i = 0; i < numThreads; ++i)
+            threads.emplace_back(worker);
+
+        // Report progress from the current thread until the workers finish.
+        std::unique_lock<std::mutex> lock(mutex);
+        int numReported = -1;
+        while (numRunning > 0 || numReported != numCompleted)
+        {
+            progressChanged.wait(lock, [&]() {
+                return numReported != numCompleted || numRunning == 0;
+            });
+
+            if (numReported != numCompleted)
+            {
+                numReported = numCompleted;
+
+                lock.unlock();
+                if (!cancelled && !options.myProgress(numReported, numSystems))
+                    cancelled = true;
+                lock.lock();
+            }
+        }
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return numCompleted == numSystems;
+}
+
+bool ScoreUtils::forEachSystem(Score &score,
+                               const std::function<void(int, System &)> &fn,
+                               const ParallelOptions &options)
+{
+    // Look up the systems before starting any threads, since this may load
+    // the systems or make private copies of them.
+    std::vector<System *> systems;
+    for (System &system : score.getSystems())
+        systems.push_back(&system);
+
+    return forEachSystemImpl(systems, fn, options);
+}
+
+bool ScoreUtils::forEachSystem(
+    const Score &score, const std::function<void(int, const System &)> &fn,
+    const ParallelOptions &options)
+{
+    // Look up the systems before starting any threads, since this may load
+    // the systems.
+    std::vector<const System *> systems;
+    for (const System &system : score.getSystems())
+        systems.push_back(&system);
+
+    return forEachSystemImpl(systems, fn, options);
+}
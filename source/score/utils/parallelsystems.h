@@ -0,0 +1,67 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_UTILS_PARALLELSYSTEMS_H
+#define SCORE_UTILS_PARALLELSYSTEMS_H
+
+#include <functional>
+
+class Score;
+class System;
+
+namespace ScoreUtils
+{
+/// Options for processing the systems of a score on multiple threads.
+struct ParallelOptions
+{
+    explicit ParallelOptions(unsigned int numThreads = 1);
+
+    /// Returns options that use one thread per hardware thread.
+    static ParallelOptions allThreads();
+
+    /// The maximum number of threads to use. By default, only the calling
+    /// thread is used, since the caller may itself be one of several workers
+    /// (e.g. pte-convert imports files in parallel). Code that owns the
+    /// process's threads, such as the editor, opts in to more threads.
+    unsigned int myNumThreads;
+
+    /// If provided, this is called from the calling thread with the number of
+    /// systems that have been processed so far and the total number of
+    /// systems. Returning false cancels any systems that haven't been started.
+    std::function<bool(int, int)> myProgress;
+};
+
+/// Calls the function for each system in the score (along with the system's
+/// index), using a pool of worker threads. The function may be called
+/// concurrently for different systems, so it must not modify anything other
+/// than the system that it is given.
+/// If the function throws, the remaining systems are cancelled and the
+/// exception is rethrown once all of the threads have finished.
+/// @return false if the operation was cancelled before every system was
+/// processed.
+bool forEachSystem(Score &score, const std::function<void(int, System &)> &fn,
+                   const ParallelOptions &options = ParallelOptions());
+
+/// Calls the function for each system in a score without modifying it. Since
+/// the systems are only read, none of them are detached from copies of the
+/// score.
+bool forEachSystem(const Score &score,
+                   const std::function<void(int, const System &)> &fn,
+                   const ParallelOptions &options = ParallelOptions());
+}
+
+#endif
@@ -17,71 +17,137 @@
 
 #include "scorepolisher.h"
 
-#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <score/score.h>
-#include <score/voiceutils.h>
+#include <score/ticks.h>
 #include <score/utils.h>
-#include <unordered_map>
-#include <unordered_set>
+#include <score/voicedurations.h>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 class TimeStamp
 {
 public:
+    TimeStamp() : myTime(0), myGraceNoteNumber(NO_GRACE_NOTE)
+    {
+    }
+
     bool operator<(const TimeStamp &other) const
     {
-        if (myTime == other.myTime)
-        {
-            // Order the timestamps so that grace notes appear before the actual
-            // note.
-            return myGraceNoteNumber.get_value_or(
-                       std::numeric_limits<int>::max()) <
-                   other.myGraceNoteNumber.get_value_or(
-                       std::numeric_limits<int>::max());
-        }
-        else
-            return myTime < other.myTime;
+        // Order the timestamps so that grace notes appear before the actual
+        // note.
+        return std::tie(myTime, myGraceNoteNumber) <
+               std::tie(other.myTime, other.myGraceNoteNumber);
     }
 
-    void advance(const boost::rational<int> &duration)
+    bool operator==(const TimeStamp &other) const
+    {
+        return myTime == other.myTime &&
+               myGraceNoteNumber == other.myGraceNoteNumber;
+    }
+
+    void advance(int64_t duration)
     {
         myTime += duration;
     }
 
     void setGraceNoteNumber(boost::optional<int> count)
     {
-        myGraceNoteNumber = count;
+        myGraceNoteNumber = count.get_value_or(NO_GRACE_NOTE);
     }
 
 private:
-    /// The time from the start of the bar.
-    boost::rational<int> myTime;
+    static const int NO_GRACE_NOTE = std::numeric_limits<int>::max();
+
+    /// The time from the start of the bar, in ticks.
+    int64_t myTime;
     /// Grace notes occur at the same timestamp as the note that they precede,
     /// but need to appear before the actual note.
-    boost::optional<int> myGraceNoteNumber;
+    int myGraceNoteNumber;
 };
 
-static int getDefaultNoteSpacing(const boost::rational<int> &duration)
+/// The position of each timestamp in a bar, sorted by timestamp. A bar only
+/// has a handful of timestamps, so a sorted vector is much cheaper to build
+/// than a tree.
+typedef std::vector<std::pair<TimeStamp, int>> TimeStampPositions;
+
+/// The timestamp of each position in a bar, sorted by address.
+typedef std::vector<std::pair<const Position *, TimeStamp>> PositionTimeStamps;
+
+/// The items that have already been moved, sorted by address.
+typedef std::vector<const void *> KnownItems;
+
+static int getDefaultNoteSpacing(int64_t duration)
+{
+    return std::max(2 * static_cast<int>(duration / Ticks::PER_QUARTER), 1);
+}
+
+static TimeStampPositions::iterator findTimestamp(
+    TimeStampPositions &timestampPositions, const TimeStamp &timestamp)
+{
+    return std::lower_bound(
+        timestampPositions.begin(), timestampPositions.end(), timestamp,
+        [](const std::pair<TimeStamp, int> &entry, const TimeStamp &t) {
+            return entry.first < t;
+        });
+}
+
+/// Returns the position of the timestamp, or 0 if the timestamp is unknown.
+static int getTimestampPosition(TimeStampPositions &timestampPositions,
+                                const TimeStamp &timestamp)
+{
+    auto it = findTimestamp(timestampPositions, timestamp);
+    if (it != timestampPositions.end() && it->first == timestamp)
+        return it->second;
+    else
+        return 0;
+}
+
+/// Returns the timestamp of the position, or the start of the bar if the
+/// position was not seen.
+static TimeStamp getPositionTimestamp(const PositionTimeStamps &timestamps,
+                                      const Position *position)
 {
-    return std::max(2 * boost::rational_cast<int>(duration), 1);
+    auto it = std::lower_bound(
+        timestamps.begin(), timestamps.end(), position,
+        [](const std::pair<const Position *, TimeStamp> &entry,
+           const Position *p) { return entry.first < p; });
+
+    if (it != timestamps.end() && it->first == position)
+        return it->second;
+    else
+        return TimeStamp();
+}
+
+/// Adds the item to the set of known items, and returns false if it was
+/// already present.
+static bool insertKnownItem(KnownItems &knownItems, const void *item)
+{
+    auto it = std::lower_bound(knownItems.begin(), knownItems.end(), item);
+    if (it != knownItems.end() && *it == item)
+        return false;
+
+    knownItems.insert(it, item);
+    return true;
 }
 
 template <typename T>
 static void shiftItemsAtPosition(const T &items, int position, int newPosition,
-                                 std::unordered_set<const void *> &knownItems)
+                                 KnownItems &knownItems)
 {
     for (auto &item : ScoreUtils::findInRange(items, position, position))
     {
-        if (knownItems.find(&item) != knownItems.end())
-            continue;
-
-        knownItems.insert(&item);
-        item.setPosition(newPosition);
+        if (insertKnownItem(knownItems, &item))
+            item.setPosition(newPosition);
     }
 }
 
 static void shiftAllItemsAtPosition(
     System &system, Staff &staff, Voice &voice, int currentPosition,
-    int newPosition, std::unordered_set<const void *> &knownItems)
+    int newPosition, KnownItems &knownItems)
 {
     shiftItemsAtPosition(voice.getIrregularGroupings(), currentPosition,
                          newPosition, knownItems);
@@ -101,40 +167,46 @@ static void shiftAllItemsAtPosition(
                          newPosition, knownItems);
 }
 
-static void computeTimestampPosition(
-    const TimeStamp &timestamp, int minPosition,
-    std::map<TimeStamp, int> &timestampPositions)
+/// Computes the position of the timestamp, which is at least the minimum
+/// position, and records it. Any following timestamps from other voices are
+/// shifted over if necessary.
+static int computeTimestampPosition(const TimeStamp &timestamp,
+                                    int minPosition,
+                                    TimeStampPositions &timestampPositions)
 {
-    int position = 0;
+    auto it = findTimestamp(timestampPositions, timestamp);
 
     // If another voice has a note at this timestamp, use that position.
-    auto it = timestampPositions.find(timestamp);
-    if (it != timestampPositions.end())
-        position = std::max(it->second, minPosition);
-    else
+    if (it != timestampPositions.end() && it->first == timestamp)
     {
-        // If this timestamp falls in between two timestamps from another voice,
-        // insert it and shift the following timestamps over if necessary.
-        it = timestampPositions.lower_bound(timestamp);
+        it->second = std::max(it->second, minPosition);
+        return it->second;
+    }
 
-        if (it != timestampPositions.begin())
-            position = std::max(boost::prior(it)->second + 1, minPosition);
-        else
-            position = 0;
+    // If this timestamp falls in between two timestamps from another voice,
+    // insert it and shift the following timestamps over if necessary.
+    int position = 0;
+    if (it != timestampPositions.begin())
+        position = std::max(std::prev(it)->second + 1, minPosition);
 
-        if (it != timestampPositions.end() && it->second <= position)
-        {
-            const int shiftAmount = (position - it->second) + 1;
-            for (; it != timestampPositions.end(); ++it)
-                it->second += shiftAmount;
-        }
+    if (it != timestampPositions.end() && it->second <= position)
+    {
+        const int shiftAmount = (position - it->second) + 1;
+        for (auto next = it; next != timestampPositions.end(); ++next)
+            next->second += shiftAmount;
     }
 
-    timestampPositions[timestamp] = position;
+    timestampPositions.emplace(it, timestamp, position);
+    return position;
 }
 
 void ScoreUtils::polishSystem(System &system)
 {
+    // These are reused for each bar to avoid reallocating them.
+    PositionTimeStamps timestamps;
+    TimeStampPositions timestampPositions;
+    KnownItems knownItems;
+
     // Format each bar separately.
     for (Barline &leftBar : system.getBarlines())
     {
@@ -142,8 +214,9 @@ void ScoreUtils::polishSystem(System &system)
         if (!rightBar)
             break;
 
-        std::unordered_map<const Position *, TimeStamp> timestamps;
-        std::map<TimeStamp, int> timestampPositions;
+        timestamps.clear();
+        timestampPositions.clear();
+        knownItems.clear();
 
         // For each timestamp, compute the maximum position at that timestamp
         // for any staff.
@@ -151,6 +224,12 @@ void ScoreUtils::polishSystem(System &system)
         {
             for (const Voice &voice : staff.getVoices())
             {
+                const auto durations = voice.getDurations();
+                const Position *firstPosition =
+                    voice.getPositions().empty()
+                        ? nullptr
+                        : &voice.getPositions().front();
+
                 TimeStamp timestamp;
                 boost::optional<int> grace_note;
                 int currentPosition = 0;
@@ -166,14 +245,14 @@ void ScoreUtils::polishSystem(System &system)
 
                     timestamp.setGraceNoteNumber(grace_note);
 
-                    computeTimestampPosition(timestamp, currentPosition,
-                                             timestampPositions);
-                    boost::rational<int> duration =
-                        VoiceUtils::getDurationTime(voice, position);
+                    const int64_t duration = durations->getDuration(
+                        static_cast<int>(&position - firstPosition));
 
-                    currentPosition = timestampPositions[timestamp] +
-                                      getDefaultNoteSpacing(duration);
-                    timestamps[&position] = timestamp;
+                    currentPosition =
+                        computeTimestampPosition(timestamp, currentPosition,
+                                                 timestampPositions) +
+                        getDefaultNoteSpacing(duration);
+                    timestamps.emplace_back(&position, timestamp);
                     timestamp.advance(duration);
                 }
 
@@ -187,14 +266,19 @@ void ScoreUtils::polishSystem(System &system)
         if (timestampPositions.empty())
             continue;
 
-        int maxPosition = std::max(1, timestampPositions.rbegin()->second);
+        std::sort(timestamps.begin(), timestamps.end(),
+                  [](const std::pair<const Position *, TimeStamp> &a,
+                     const std::pair<const Position *, TimeStamp> &b) {
+                      return a.first < b.first;
+                  });
+
+        int maxPosition = std::max(1, timestampPositions.back().second);
 
         // Adjust!
         const int startPos =
             (leftBar.getPosition() == 0) ? 0 : leftBar.getPosition() + 1;
         const int oldEndPos = rightBar->getPosition();
         const int endPos = startPos + maxPosition;
-        std::unordered_set<const void *> knownItems;
 
         if (endPos > oldEndPos)
         {
@@ -224,10 +308,12 @@ void ScoreUtils::polishSystem(System &system)
                 {
                     // Since we're moving around irregular groups, we need to
                     // have precomputed the durations of each position.
-                    TimeStamp timestamp = timestamps[&pos];
+                    const TimeStamp timestamp =
+                        getPositionTimestamp(timestamps, &pos);
                     const int currentPosition = pos.getPosition();
                     const int newPosition =
-                        startPos + timestampPositions[timestamp];
+                        startPos +
+                        getTimestampPosition(timestampPositions, timestamp);
 
                     // Move any irregular groups, etc that start at this
                     // position. If the group moves forward, we need to be
@@ -243,8 +329,8 @@ void ScoreUtils::polishSystem(System &system)
     }
 }
 
-void ScoreUtils::polishScore(Score &score)
+bool ScoreUtils::polishScore(Score &score, const ParallelOptions &options)
 {
-    for (System &system : score.getSystems())
-        polishSystem(system);
+    return forEachSystem(
+        score, [](int, System &system) { polishSystem(system); }, options);
 }
@@ -18,13 +18,20 @@
 #ifndef SCORE_UTILS_SCOREPOLISHER_H
 #define SCORE_UTILS_SCOREPOLISHER_H
 
+#include <score/utils/parallelsystems.h>
+
 class Score;
 class System;
 
 namespace ScoreUtils
 {
-/// Reformats the score.
-void polishScore(Score &score);
+/// Reformats the score. Each system is reformatted independently, so the
+/// systems can be processed in parallel and the result does not depend on the
+/// number of threads.
+/// @return false if the operation was cancelled, in which case only some of
+/// the systems have been reformatted.
+bool polishScore(Score &score,
+                 const ParallelOptions &options = ParallelOptions());
 /// Reformats a single system.
 void polishSystem(System &system);
 }
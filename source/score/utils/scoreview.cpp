@@ -0,0 +1,118 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "scoreview.h"
+
+#include <algorithm>
+#include <score/score.h>
+#include <score/voicedurations.h>
+
+ScoreView::ScoreView(const Score &score)
+{
+    size_t numPositions = 0;
+    size_t numNotes = 0;
+    for (const System &system : score.getSystems())
+    {
+        for (const Staff &staff : system.getStaves())
+        {
+            for (const Voice &voice : staff.getVoices())
+            {
+                for (const Position &pos : voice.getPositions())
+                {
+                    ++numPositions;
+                    numNotes += pos.getNotes().size();
+                }
+            }
+        }
+    }
+
+    myPositions.reserve(numPositions);
+    myPositionLocations.reserve(numPositions);
+    myDurations.reserve(numPositions);
+    myNoteOffsets.reserve(numPositions + 1);
+    myNotes.reserve(numNotes);
+    myNoteStrings.reserve(numNotes);
+    myNoteFrets.reserve(numNotes);
+
+    int staffCount = 0;
+    for (const System &system : score.getSystems())
+    {
+        mySystemStaffOffsets.push_back(staffCount);
+        staffCount += static_cast<int>(system.getStaves().size());
+
+        for (const Staff &staff : system.getStaves())
+        {
+            for (const Voice &voice : staff.getVoices())
+            {
+                myVoiceOffsets.push_back(static_cast<int>(myPositions.size()));
+
+                const auto durations = voice.getDurations();
+                int voicePosition = 0;
+                for (const Position &pos : voice.getPositions())
+                {
+                    myPositions.push_back(&pos);
+                    myPositionLocations.push_back(pos.getPosition());
+                    myDurations.push_back(
+                        durations->getDuration(voicePosition++));
+                    myNoteOffsets.push_back(static_cast<int>(myNotes.size()));
+
+                    for (const Note &note : pos.getNotes())
+                    {
+                        myNotes.push_back(&note);
+                        myNoteStrings.push_back(
+                            static_cast<int8_t>(note.getString()));
+                        myNoteFrets.push_back(
+                            static_cast<int8_t>(note.getFretNumber()));
+                    }
+                }
+            }
+        }
+    }
+
+    myVoiceOffsets.push_back(static_cast<int>(myPositions.size()));
+    myNoteOffsets.push_back(static_cast<int>(myNotes.size()));
+}
+
+int ScoreView::getVoiceIndex(int system, int staff, int voice) const
+{
+    return (mySystemStaffOffsets[system] + staff) * Staff::NUM_VOICES + voice;
+}
+
+ScoreView::IndexRange ScoreView::getPositions(int voice) const
+{
+    return IndexRange(myVoiceOffsets[voice], myVoiceOffsets[voice + 1]);
+}
+
+ScoreView::IndexRange ScoreView::findPositionsInRange(int voice, int left,
+                                                      int right) const
+{
+    auto begin = myPositionLocations.begin() + myVoiceOffsets[voice];
+    auto end = myPositionLocations.begin() + myVoiceOffsets[voice + 1];
+
+    auto first = std::lower_bound(begin, end, left);
+    auto last = std::lower_bound(first, end, right);
+
+    return IndexRange(
+        static_cast<int>(first - myPositionLocations.begin()),
+        static_cast<int>(last - myPositionLocations.begin()));
+}
+
+int ScoreView::findPosition(int voice, int location) const
+{
+    IndexRange range = findPositionsInRange(voice, location, location + 1);
+    return range.first != range.second ? range.first : -1;
+}
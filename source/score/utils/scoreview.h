@@ -0,0 +1,98 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_UTILS_SCOREVIEW_H
+#define SCORE_UTILS_SCOREVIEW_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Note;
+class Position;
+class Score;
+
+/// A read-only, flattened view of the positions and notes in a score, for
+/// passes (such as MIDI generation) that scan through the entire score.
+/// The positions and notes of every voice are stored in contiguous arrays,
+/// along with each position's duration.
+/// The view refers to the score's positions and notes, so it must be rebuilt
+/// after the score is modified.
+class ScoreView
+{
+public:
+    /// A half-open range [first, last) of indices into the position or note
+    /// arrays.
+    typedef std::pair<int, int> IndexRange;
+
+    explicit ScoreView(const Score &score);
+
+    /// Returns the index of the specified voice, for use with getPositions().
+    int getVoiceIndex(int system, int staff, int voice) const;
+
+    /// Returns the positions in the voice.
+    IndexRange getPositions(int voice) const;
+    /// Returns the positions in the voice with a location in [left, right).
+    IndexRange findPositionsInRange(int voice, int left, int right) const;
+    /// Returns the index of the position at the given location in the voice,
+    /// or -1 if there isn't one.
+    int findPosition(int voice, int location) const;
+
+    const Position &getPosition(int index) const
+    {
+        return *myPositions[index];
+    }
+    /// Returns the location of the position within its staff.
+    int getPositionLocation(int index) const
+    {
+        return myPositionLocations[index];
+    }
+    /// Returns the position's duration in ticks (see Ticks::PER_QUARTER).
+    int64_t getDuration(int index) const
+    {
+        return myDurations[index];
+    }
+    /// Returns the notes in the position.
+    IndexRange getNotes(int index) const
+    {
+        return IndexRange(myNoteOffsets[index], myNoteOffsets[index + 1]);
+    }
+
+    const Note &getNote(int index) const { return *myNotes[index]; }
+    int getNoteString(int index) const { return myNoteStrings[index]; }
+    int getNoteFret(int index) const { return myNoteFrets[index]; }
+
+private:
+    /// The index of each system's first staff.
+    std::vector<int> mySystemStaffOffsets;
+    /// The index of each voice's first position. This has an extra entry at
+    /// the end for the total number of positions.
+    std::vector<int> myVoiceOffsets;
+
+    std::vector<const Position *> myPositions;
+    std::vector<int> myPositionLocations;
+    std::vector<int64_t> myDurations;
+    /// The index of each position's first note, with an extra entry at the
+    /// end for the total number of notes.
+    std::vector<int> myNoteOffsets;
+
+    std::vector<const Note *> myNotes;
+    std::vector<int8_t> myNoteStrings;
+    std::vector<int8_t> myNoteFrets;
+};
+
+#endif
@@ -19,20 +19,65 @@
 
 #include <score/score.h>
 
+FilterRule::NameMatcher::NameMatcher(const NameMatcher &other)
+{
+    *this = other;
+}
+
+FilterRule::NameMatcher &FilterRule::NameMatcher::operator=(
+    const NameMatcher &other)
+{
+    if (this == &other)
+        return *this;
+
+    std::lock(myMutex, other.myMutex);
+    std::lock_guard<std::mutex> lock(myMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> other_lock(other.myMutex, std::adopt_lock);
+
+    myRegex = other.myRegex;
+    myResults = other.myResults;
+    return *this;
+}
+
+void FilterRule::NameMatcher::compile(const std::string &pattern)
+{
+    boost::regex regex(pattern);
+
+    std::lock_guard<std::mutex> lock(myMutex);
+    myRegex = std::move(regex);
+    myResults.clear();
+}
+
+bool FilterRule::NameMatcher::matches(const InternedString &name)
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    auto it = myResults.find(name);
+    if (it == myResults.end())
+    {
+        it = myResults.emplace(name, boost::regex_match(name.str(), myRegex))
+                 .first;
+    }
+
+    return it->second;
+}
+
 FilterRule::FilterRule()
     : mySubject(Subject::PLAYER_NAME),
       myOperation(Operation::EQUAL),
       myIntValue(0)
 {
+    myNameMatcher.compile(myStrValue);
 }
 
 FilterRule::FilterRule(Subject subject, std::string value)
     : mySubject(subject),
       myOperation(Operation::EQUAL),
       myIntValue(0),
-      myStrValue(std::move(value)),
-      myRegex(myStrValue)
+      myStrValue(std::move(value))
 {
+    // Report an invalid regular expression immediately.
+    myNameMatcher.compile(myStrValue);
 }
 
 FilterRule::FilterRule(Subject subject, Operation op, int value)
@@ -85,7 +130,7 @@ bool FilterRule::accept(const Score &score, const ActivePlayer &p) const
     switch (mySubject)
     {
     case PLAYER_NAME:
-        return boost::regex_match(player.getDescription(), myRegex);
+        return matchesName(player.getInternedDescription());
     case NUM_STRINGS:
     {
         const int value = player.getTuning().getStringCount();
@@ -110,6 +155,11 @@ bool FilterRule::accept(const Score &score, const ActivePlayer &p) const
     }
 }
 
+bool FilterRule::matchesName(const InternedString &name) const
+{
+    return myNameMatcher.matches(name);
+}
+
 ViewFilter::ViewFilter()
 {
 }
@@ -18,11 +18,15 @@
 #ifndef SCORE_VIEWFILTER_H
 #define SCORE_VIEWFILTER_H
 
+#include "archivetraits.h"
 #include <boost/range/iterator_range_core.hpp>
 #include <boost/regex.hpp>
 #include <cassert>
 #include "fileversion.h"
+#include "internedstring.h"
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class ActivePlayer;
@@ -69,11 +73,39 @@ public:
 private:
     bool accept(const Score &score, const ActivePlayer &player) const;
 
+    /// Returns whether the player name matches the regular expression.
+    bool matchesName(const InternedString &name) const;
+
+    /// The compiled regular expression, along with the result of matching it
+    /// against each player name. The same few names are checked for every
+    /// staff in the score, so each name only needs to be matched once.
+    class NameMatcher
+    {
+    public:
+        NameMatcher() = default;
+        /// Copies the compiled expression and the cached results.
+        NameMatcher(const NameMatcher &other);
+        NameMatcher &operator=(const NameMatcher &other);
+
+        /// @throw boost::regex_error if the pattern is invalid.
+        void compile(const std::string &pattern);
+
+        bool matches(const InternedString &name);
+
+    private:
+        mutable std::mutex myMutex;
+        boost::regex myRegex;
+        std::unordered_map<InternedString, bool, InternedString::Hash>
+            myResults;
+    };
+
     Subject mySubject;
     Operation myOperation;
     int myIntValue;
     std::string myStrValue;
-    boost::regex myRegex;
+    /// Each copy of the rule has its own matcher, which is compiled whenever
+    /// the value is set (including when the rule is loaded from a file).
+    mutable NameMatcher myNameMatcher;
 };
 
 /// A filter that specifies which staves are visible.
@@ -122,6 +154,10 @@ void FilterRule::serialize(Archive &ar, const FileVersion /*version*/)
     {
     case PLAYER_NAME:
         ar("value", myStrValue);
+        // Report an invalid regular expression while loading the file rather
+        // than when the score is rendered.
+        if (ScoreUtils::isLoading<Archive>())
+            myNameMatcher.compile(myStrValue);
         break;
     case NUM_STRINGS:
         ar("value", myIntValue);
@@ -17,12 +17,75 @@
 
 #include "voice.h"
 
+#include <cassert>
 #include "utils.h"
+#include "voicedurations.h"
 
 Voice::Voice()
 {
 }
 
+Voice::Voice(const Voice &other)
+    : myPositions(other.myPositions),
+      myIrregularGroupings(other.myIrregularGroupings),
+      myContentHash(other.myContentHash)
+{
+    // The cached durations are immutable, so they can be shared.
+    std::lock_guard<std::mutex> lock(other.myDurationsMutex);
+    myDurations = other.myDurations;
+}
+
+Voice::Voice(Voice &&other)
+    : myPositions(std::move(other.myPositions)),
+      myIrregularGroupings(std::move(other.myIrregularGroupings)),
+      myContentHash(other.myContentHash)
+{
+    std::lock_guard<std::mutex> lock(other.myDurationsMutex);
+    myDurations = std::move(other.myDurations);
+}
+
+Voice &Voice::operator=(const Voice &other)
+{
+    if (this != &other)
+    {
+        myPositions = other.myPositions;
+        myIrregularGroupings = other.myIrregularGroupings;
+        myContentHash = other.myContentHash;
+
+        std::shared_ptr<const VoiceDurations> durations;
+        {
+            std::lock_guard<std::mutex> lock(other.myDurationsMutex);
+            durations = other.myDurations;
+        }
+
+        std::lock_guard<std::mutex> lock(myDurationsMutex);
+        myDurations = durations;
+    }
+
+    return *this;
+}
+
+Voice &Voice::operator=(Voice &&other)
+{
+    if (this != &other)
+    {
+        myPositions = std::move(other.myPositions);
+        myIrregularGroupings = std::move(other.myIrregularGroupings);
+        myContentHash = other.myContentHash;
+
+        std::shared_ptr<const VoiceDurations> durations;
+        {
+            std::lock_guard<std::mutex> lock(other.myDurationsMutex);
+            durations = std::move(other.myDurations);
+        }
+
+        std::lock_guard<std::mutex> lock(myDurationsMutex);
+        myDurations = std::move(durations);
+    }
+
+    return *this;
+}
+
 bool Voice::operator==(const Voice &other) const
 {
     return myPositions == other.myPositions &&
@@ -31,6 +94,7 @@ bool Voice::operator==(const Voice &other) const
 
 boost::iterator_range<Voice::PositionIterator> Voice::getPositions()
 {
+    invalidateCaches();
     return boost::make_iterator_range(myPositions);
 }
 
@@ -41,17 +105,26 @@ boost::iterator_range<Voice::PositionConstIterator> Voice::getPositions() const
 
 void Voice::insertPosition(const Position &position)
 {
+    invalidateCaches();
     ScoreUtils::insertObject(myPositions, position);
 }
 
+void Voice::insertPositions(std::vector<Position> positions)
+{
+    invalidateCaches();
+    ScoreUtils::insertObjects(myPositions, std::move(positions));
+}
+
 void Voice::removePosition(const Position &position)
 {
+    invalidateCaches();
     ScoreUtils::removeObject(myPositions, position);
 }
 
 boost::iterator_range<Voice::IrregularGroupingIterator>
 Voice:: getIrregularGroupings()
 {
+    invalidateCaches();
     return boost::make_iterator_range(myIrregularGroupings);
 }
 
@@ -63,10 +136,53 @@ Voice:: getIrregularGroupings() const
 
 void Voice::insertIrregularGrouping(const IrregularGrouping &group)
 {
+    invalidateCaches();
     ScoreUtils::insertObject(myIrregularGroupings, group);
 }
 
+void Voice::insertIrregularGroupings(std::vector<IrregularGrouping> groups)
+{
+    invalidateCaches();
+    ScoreUtils::insertObjects(myIrregularGroupings, std::move(groups));
+}
+
 void Voice::removeIrregularGrouping(const IrregularGrouping &group)
 {
+    invalidateCaches();
     ScoreUtils::removeObject(myIrregularGroupings, group);
 }
+
+std::shared_ptr<const VoiceDurations> Voice::getDurations() const
+{
+    std::lock_guard<std::mutex> lock(myDurationsMutex);
+
+    if (!myDurations)
+        myDurations = std::make_shared<VoiceDurations>(*this);
+#ifndef NDEBUG
+    else
+    {
+        // Fails if a position was edited through a stale reference.
+        assert(*myDurations == VoiceDurations(*this));
+    }
+#endif
+
+    return myDurations;
+}
+
+uint64_t Voice::getContentHash() const
+{
+    return myContentHash.get([this]() {
+        ScoreUtils::ContentHasher hasher;
+        hasher.addRange(myPositions);
+        hasher.addRange(myIrregularGroupings);
+        return hasher.getHash();
+    });
+}
+
+void Voice::invalidateCaches()
+{
+    myContentHash.reset();
+
+    std::lock_guard<std::mutex> lock(myDurationsMutex);
+    myDurations.reset();
+}
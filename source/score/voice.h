@@ -18,16 +18,26 @@
 #ifndef SCORE_VOICE_H
 #define SCORE_VOICE_H
 
+#include "archivetraits.h"
 #include <boost/range/iterator_range_core.hpp>
+#include "contenthash.h"
 #include "fileversion.h"
 #include "irregulargrouping.h"
+#include <memory>
+#include <mutex>
 #include "position.h"
 #include <vector>
 
+class VoiceDurations;
+
 class Voice
 {
 public:
     Voice();
+    Voice(const Voice &other);
+    Voice(Voice &&other);
+    Voice &operator=(const Voice &other);
+    Voice &operator=(Voice &&other);
 
     typedef std::vector<Position>::iterator PositionIterator;
     typedef std::vector<Position>::const_iterator PositionConstIterator;
@@ -40,20 +50,26 @@ public:
     template <class Archive>
     void serialize(Archive &ar, const FileVersion version);
 
-    /// Returns the set of positions in the voice.
+    /// Returns the set of positions in the voice. Since the positions may be
+    /// modified through the range, this discards the cached durations and
+    /// content hash.
     boost::iterator_range<PositionIterator> getPositions();
     /// Returns the set of positions in the voice.
     boost::iterator_range<PositionConstIterator> getPositions() const;
 
     /// Adds a new position to the voice.
     void insertPosition(const Position &position);
+    /// Adds a batch of positions to the voice. This is faster than inserting
+    /// the positions individually, e.g. when importing or pasting.
+    void insertPositions(std::vector<Position> positions);
     /// Removes any positions that satisfy the given predicate.
     template <typename Predicate>
     void removePositions(Predicate p);
     /// Removes the specified position from the voice.
     void removePosition(const Position &position);
 
-    /// Returns the set of irregular groupings in the voice.
+    /// Returns the set of irregular groupings in the voice. This discards the
+    /// cached durations and content hash.
     boost::iterator_range<IrregularGroupingIterator> getIrregularGroupings();
     /// Returns the set of irregular groupings in the voice.
     boost::iterator_range<IrregularGroupingConstIterator>
@@ -61,17 +77,47 @@ public:
 
     /// Adds a new irregular grouping to the voice.
     void insertIrregularGrouping(const IrregularGrouping &group);
+    /// Adds a batch of irregular groupings to the voice.
+    void insertIrregularGroupings(std::vector<IrregularGrouping> groups);
     /// Removes the specified irregular grouping from the voice.
     void removeIrregularGrouping(const IrregularGrouping &group);
 
+    /// Returns the duration and start time of each position in the voice.
+    /// These are computed when first needed, and are cached until one of the
+    /// voice's non-const methods is called. A position that is modified
+    /// through a reference obtained before the durations were computed is
+    /// not detected, so edits must look up the positions again. In debug
+    /// builds, the cached durations are checked against the voice's contents
+    /// to catch this.
+    std::shared_ptr<const VoiceDurations> getDurations() const;
+
+    /// Returns a hash of the voice's contents. This is cached in the same way
+    /// as the durations, with the same restriction (and debug check) for
+    /// positions modified through an old reference.
+    uint64_t getContentHash() const;
+
 private:
+    /// Discards the cached durations and content hash.
+    void invalidateCaches();
+
     std::vector<Position> myPositions;
     std::vector<IrregularGrouping> myIrregularGroupings;
+
+    /// The voice may be shared between threads (e.g. with the MIDI player's
+    /// copy of the score), so the cache is guarded by a mutex.
+    mutable std::mutex myDurationsMutex;
+    mutable std::shared_ptr<const VoiceDurations> myDurations;
+    ScoreUtils::CachedContentHash myContentHash;
 };
 
 template <class Archive>
 void Voice::serialize(Archive &ar, const FileVersion /*version*/)
 {
+    // Loading replaces the positions, so discard the cached durations and
+    // hash.
+    if (ScoreUtils::isLoading<Archive>())
+        invalidateCaches();
+
     ar("positions", myPositions);
     ar("irregular_groupings", myIrregularGroupings);
 }
@@ -79,6 +125,7 @@ void Voice::serialize(Archive &ar, const FileVersion /*version*/)
 template <typename Predicate>
 void Voice::removePositions(Predicate p)
 {
+    invalidateCaches();
     myPositions.erase(std::remove_if(myPositions.begin(), myPositions.end(), p),
                       myPositions.end());
 }
@@ -0,0 +1,105 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include "voicedurations.h"
+
+#include <algorithm>
+#include "utils.h"
+#include "voice.h"
+
+VoiceDurations::VoiceDurations(const Voice &voice)
+{
+    const auto positions = voice.getPositions();
+    const int count = static_cast<int>(positions.size());
+    myDurations.reserve(count);
+
+    for (const Position &pos : positions)
+    {
+        if (pos.hasProperty(Position::Acciaccatura))
+        {
+            myDurations.push_back(0);
+            continue;
+        }
+
+        int64_t duration =
+            4 * Ticks::PER_QUARTER / static_cast<int>(pos.getDurationType());
+
+        // Adjust for dotted notes.
+        if (pos.hasProperty(Position::Dotted))
+            duration += duration / 2;
+        if (pos.hasProperty(Position::DoubleDotted))
+            duration += duration * 3 / 4;
+
+        myDurations.push_back(duration);
+    }
+
+    // Adjust for irregular groups. As an example, with triplets we have 3
+    // notes played in the time of 2, so each note is 2/3 of its normal
+    // duration. This is exact unless irregular groups are nested.
+    for (const IrregularGrouping &group : voice.getIrregularGroupings())
+    {
+        const int first =
+            ScoreUtils::findIndexByPosition(positions, group.getPosition());
+        if (first < 0)
+            continue;
+
+        const int last = std::min(count, first + group.getLength());
+        for (int i = first; i < last; ++i)
+        {
+            myDurations[i] = myDurations[i] * group.getNotesPlayedOver() /
+                             group.getNotesPlayed();
+        }
+    }
+
+    myStartTimes.reserve(count + 1);
+    myStartTimes.push_back(0);
+    for (int64_t duration : myDurations)
+        myStartTimes.push_back(myStartTimes.back() + duration);
+}
+
+bool VoiceDurations::operator==(const VoiceDurations &other) const
+{
+    // The start times are computed from the durations.
+    return myDurations == other.myDurations;
+}
+
+int VoiceDurations::getPositionCount() const
+{
+    return static_cast<int>(myDurations.size());
+}
+
+int64_t VoiceDurations::getDuration(int index) const
+{
+    return myDurations[index];
+}
+
+int64_t VoiceDurations::getStartTime(int index) const
+{
+    return myStartTimes[index];
+}
+
+int VoiceDurations::findPositionAt(int64_t time) const
+{
+    if (time < 0 || time >= myStartTimes.back())
+        return -1;
+
+    // Find the last position that starts at or before the time. Grace notes
+    // have no duration, so this skips over them to the note that they lead
+    // into.
+    auto it = std::upper_bound(myStartTimes.begin(), myStartTimes.end(), time);
+    return static_cast<int>(it - myStartTimes.begin()) - 1;
+}
@@ -0,0 +1,59 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#ifndef SCORE_VOICEDURATIONS_H
+#define SCORE_VOICEDURATIONS_H
+
+#include <cstdint>
+#include "ticks.h"
+#include <vector>
+
+class Voice;
+
+/// The duration and start time of each position in a voice, which are
+/// computed together in a single pass over the voice.
+/// Times are measured in ticks (see Ticks::PER_QUARTER).
+class VoiceDurations
+{
+public:
+    explicit VoiceDurations(const Voice &voice);
+
+    bool operator==(const VoiceDurations &other) const;
+
+    /// Returns the number of positions in the voice.
+    int getPositionCount() const;
+
+    /// Returns the duration of the position at the given index in the voice.
+    int64_t getDuration(int index) const;
+
+    /// Returns the total duration of the positions before the given index.
+    /// The index may also be the number of positions, which gives the
+    /// duration of the entire voice.
+    int64_t getStartTime(int index) const;
+
+    /// Returns the index of the position that is played at the given time,
+    /// or -1 if the time is outside of the voice.
+    int findPositionAt(int64_t time) const;
+
+private:
+    std::vector<int64_t> myDurations;
+    /// The start time of each position, with an extra entry at the end for
+    /// the total duration.
+    std::vector<int64_t> myStartTimes;
+};
+
+#endif
@@ -17,10 +17,12 @@
 
 #include "voiceutils.h"
 
+#include <algorithm>
 #include <boost/range/adaptor/reversed.hpp>
 #include "score.h"
 #include "scorelocation.h"
 #include "utils.h"
+#include "voicedurations.h"
 
 namespace VoiceUtils
 {
@@ -133,6 +135,23 @@ std::vector<const IrregularGrouping *> getIrregularGroupsInRange(
 
 boost::rational<int> getDurationTime(const Voice &voice, const Position &pos)
 {
+    // Look up the position's index in the cached durations, provided that it
+    // is actually one of the voice's positions.
+    const auto positions = voice.getPositions();
+    auto it = std::lower_bound(
+        positions.begin(), positions.end(), pos.getPosition(),
+        [](const Position &p, int position) {
+            return p.getPosition() < position;
+        });
+
+    if (it != positions.end() && &*it == &pos)
+    {
+        const int index = static_cast<int>(it - positions.begin());
+        return Ticks::toRational(voice.getDurations()->getDuration(index));
+    }
+
+    // The position is not part of the voice (e.g. a copy of a position that
+    // is being edited), so compute its duration directly.
     if (pos.hasProperty(Position::Acciaccatura))
         return 0;
 
@@ -36,6 +36,14 @@ static QString getShortcutHint(const QAction &action)
         return "";
 }
 
+/// Formats a time in milliseconds as e.g. "2:31".
+static QString formatTime(int milliseconds)
+{
+    const int seconds = milliseconds / 1000;
+    return QString("%1:%2").arg(seconds / 60).arg(seconds % 60, 2, 10,
+                                                   QChar('0'));
+}
+
 static QString extractPercent(const QString &text, const QLocale &locale)
 {
     QString number_only(text);
@@ -125,6 +133,20 @@ PlaybackWidget::PlaybackWidget(const QAction &play_pause_command,
     connectButtonToAction(ui->rewindToStartButton, &rewind_command);
     connectButtonToAction(ui->stopButton, &stop_command);
 
+    // Seek once the slider is released, or immediately if the slider was
+    // moved by clicking or with the keyboard.
+    ui->timeSlider->setRange(0, 0);
+    ui->timeSlider->setPageStep(10000);
+    ui->timeSlider->setSingleStep(1000);
+    connect(ui->timeSlider, &QSlider::sliderReleased, [=]() {
+        seekRequested(ui->timeSlider->value());
+    });
+    connect(ui->timeSlider, &QSlider::valueChanged, [=](int value) {
+        updateTimeLabel();
+        if (!ui->timeSlider->isSliderDown())
+            seekRequested(value);
+    });
+
     connect(ui->zoomComboBox, &QComboBox::currentTextChanged,
             [=](const QString &text) {
         QLocale locale;
@@ -205,3 +227,24 @@ void PlaybackWidget::updateLocationLabel(const std::string &location)
 {
     ui->locationLabel->setText(QString::fromStdString(location));
 }
+
+void PlaybackWidget::setPlaybackTime(int elapsed, int total)
+{
+    // Don't interfere with the user dragging the slider.
+    if (ui->timeSlider->isSliderDown())
+        return;
+
+    ui->timeSlider->blockSignals(true);
+    ui->timeSlider->setRange(0, total);
+    ui->timeSlider->setValue(elapsed);
+    ui->timeSlider->blockSignals(false);
+
+    updateTimeLabel();
+}
+
+void PlaybackWidget::updateTimeLabel()
+{
+    ui->timeLabel->setText(QString("%1 / %2")
+                               .arg(formatTime(ui->timeSlider->value()))
+                               .arg(formatTime(ui->timeSlider->maximum())));
+}
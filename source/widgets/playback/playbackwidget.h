@@ -50,15 +50,22 @@ public:
     /// Updates the text containing the caret's location.
     void updateLocationLabel(const std::string &location);
 
+    /// Updates the elapsed and total playback time, in milliseconds.
+    void setPlaybackTime(int elapsed, int total);
+
 signals:
     void playbackSpeedChanged(int speed);
     void activeVoiceChanged(int voice);
     void activeFilterChanged(int filter);
     void zoomChanged(double zoom);
+    /// Emitted when the user moves the time slider, with the new time in
+    /// milliseconds.
+    void seekRequested(int milliseconds);
 
 private:
     void onSettingChanged(const std::string &setting);
     double validateZoom(double percent);
+    void updateTimeLabel();
 
     Ui::PlaybackWidget *ui;
     QButtonGroup *myVoices;
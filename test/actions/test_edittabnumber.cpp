@@ -52,3 +52,32 @@ TEST_CASE_METHOD(ActionFixture, "Actions/EditTabNumber/HighTappedHarmonic", "")
     REQUIRE(myLocation.getNote()->getFretNumber() == 5);
     REQUIRE(myLocation.getNote()->getTappedHarmonicFret() == 29);
 }
+
+TEST_CASE_METHOD(ActionFixture, "Actions/EditTabNumber/Merge", "")
+{
+    myLocation.getNote()->setFretNumber(5);
+
+    // Typing "1" and then "2" should be merged into a single edit.
+    EditTabNumber action(myLocation, 1);
+    action.redo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 1);
+
+    EditTabNumber action2(myLocation, 2);
+    action2.redo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 12);
+
+    REQUIRE(action.id() == action2.id());
+    REQUIRE(action.mergeWith(&action2));
+
+    action.undo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 5);
+
+    action.redo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 12);
+
+    // Edits to a different note are not merged.
+    ScoreLocation location(myLocation);
+    location.setString(5);
+    EditTabNumber action3(location, 4);
+    REQUIRE(!action.mergeWith(&action3));
+}
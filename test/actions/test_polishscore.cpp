@@ -0,0 +1,69 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <actions/polishscore.h>
+#include <score/score.h>
+#include <score/utils/memoryusage.h>
+#include <score/utils/scorepolisher.h>
+
+TEST_CASE("Actions/PolishScore", "")
+{
+    Score score;
+    System system;
+    Staff staff;
+    Voice &voice = staff.getVoices().front();
+
+    Position pos1(3);
+    pos1.insertNote(Note(1, 2));
+    voice.insertPosition(pos1);
+    Position pos2(20);
+    pos2.insertNote(Note(2, 3));
+    voice.insertPosition(pos2);
+    system.insertStaff(staff);
+
+    // The first system is already polished, so only the second system should
+    // be modified.
+    System polished(system);
+    ScoreUtils::polishSystem(polished);
+    REQUIRE(!(polished == system));
+
+    score.insertSystem(polished);
+    score.insertSystem(system);
+
+    PolishScore action(score);
+    REQUIRE(action.getMemoryUsage() == 0);
+
+    // The unmodified system should stay shared with other copies of the
+    // score, e.g. the MIDI player's.
+    const Score copy(score);
+    const Score &const_score = score;
+
+    action.redo();
+    REQUIRE(&const_score.getSystems()[0] == &copy.getSystems()[0]);
+    REQUIRE(copy.getSystems()[1] == system);
+    REQUIRE(score.getSystems()[0] == polished);
+    REQUIRE(score.getSystems()[1] == polished);
+    REQUIRE(action.getMemoryUsage() ==
+            ScoreUtils::estimateMemoryUsage(system));
+
+    action.undo();
+    REQUIRE(score.getSystems()[0] == polished);
+    REQUIRE(score.getSystems()[1] == system);
+    REQUIRE(action.getMemoryUsage() == 0);
+}
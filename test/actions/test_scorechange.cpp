@@ -0,0 +1,80 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <actions/scorechange.h>
+
+TEST_CASE("Actions/ScoreChange/Empty", "")
+{
+    ScoreChange change;
+
+    REQUIRE(change.isEmpty());
+    REQUIRE(!change.affectsAnySystem());
+    REQUIRE(!change.affectsAnyPlayer());
+    REQUIRE(!change.affectsAnyInstrument());
+    REQUIRE(!change.affectsProperty(ScoreChange::AllProperties));
+    REQUIRE(change == ScoreChange());
+}
+
+TEST_CASE("Actions/ScoreChange/Systems", "")
+{
+    ScoreChange change = ScoreChange::system(3) | ScoreChange::system(1);
+    change |= ScoreChange::system(3);
+
+    REQUIRE(!change.isEmpty());
+    REQUIRE(change.affectsAnySystem());
+    REQUIRE(!change.affectsAllSystems());
+    REQUIRE(change.affectsSystem(1));
+    REQUIRE(!change.affectsSystem(2));
+    REQUIRE(change.getSystems() == std::vector<int>({ 1, 3 }));
+    REQUIRE(!change.affectsAnyPlayer());
+
+    change |= ScoreChange::allSystems();
+    REQUIRE(change.affectsAllSystems());
+    REQUIRE(change.affectsSystem(2));
+    REQUIRE(change == ScoreChange::allSystems());
+}
+
+TEST_CASE("Actions/ScoreChange/PlayersAndInstruments", "")
+{
+    ScoreChange change =
+        ScoreChange::player(2) | ScoreChange::allInstruments();
+
+    REQUIRE(!change.affectsAnySystem());
+    REQUIRE(change.affectsPlayer(2));
+    REQUIRE(!change.affectsPlayer(0));
+    REQUIRE(!change.affectsAllPlayers());
+    REQUIRE(change.affectsAllInstruments());
+    REQUIRE(change.affectsInstrument(5));
+    REQUIRE(!(change == ScoreChange::player(2)));
+}
+
+TEST_CASE("Actions/ScoreChange/Properties", "")
+{
+    ScoreChange change = ScoreChange::properties(ScoreChange::ViewFilters);
+
+    REQUIRE(change.affectsProperty(ScoreChange::ViewFilters));
+    REQUIRE(!change.affectsProperty(ScoreChange::ScoreInfo));
+    REQUIRE(!change.affectsAnySystem());
+
+    ScoreChange everything = ScoreChange::everything();
+    REQUIRE(everything.affectsAllSystems());
+    REQUIRE(everything.affectsAllPlayers());
+    REQUIRE(everything.affectsAllInstruments());
+    REQUIRE(everything.affectsProperty(ScoreChange::LineSpacing));
+}
@@ -0,0 +1,156 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <actions/undomanager.h>
+#include <actions/undomemoryusage.h>
+
+namespace
+{
+/// A command that reports a fixed memory usage, and optionally merges with
+/// other commands by adding their memory usage.
+class TestCommand : public QUndoCommand, public UndoMemoryUsage
+{
+public:
+    TestCommand(size_t bytes, bool mergeable = false)
+        : myBytes(bytes), myMergeable(mergeable)
+    {
+    }
+
+    virtual int id() const override
+    {
+        return myMergeable ? 1 : -1;
+    }
+
+    virtual bool mergeWith(const QUndoCommand *other) override
+    {
+        myBytes += static_cast<const TestCommand *>(other)->myBytes;
+        return true;
+    }
+
+    virtual size_t getMemoryUsage() const override
+    {
+        return myBytes;
+    }
+
+private:
+    size_t myBytes;
+    const bool myMergeable;
+};
+}
+
+TEST_CASE("Actions/UndoManager/MemoryLimit", "")
+{
+    UndoManager manager;
+    manager.addNewUndoStack();
+    manager.setActiveStackIndex(0);
+
+    // Track the modified state in the same way as the main window, which
+    // uses it to decide whether to prompt before closing the document.
+    bool windowModified = false;
+    QObject::connect(&manager, &UndoManager::modifiedChanged,
+                     [&](bool modified) { windowModified = modified; });
+
+    manager.push(new QUndoCommand("Edit 1"), 0);
+    REQUIRE(manager.isModified());
+    REQUIRE(windowModified);
+
+    // The history is discarded before the next action, which leaves the
+    // stack clean even though the first edit was never saved.
+    manager.setMemoryLimit(1);
+    manager.push(new QUndoCommand("Edit 2"), 0);
+    REQUIRE(manager.activeStack()->count() == 1);
+
+    manager.undo();
+    REQUIRE(manager.activeStack()->isClean());
+    REQUIRE(manager.isModified());
+    REQUIRE(windowModified);
+
+    // Saving the document makes it unmodified again.
+    manager.setClean();
+    REQUIRE(!manager.isModified());
+    REQUIRE(!windowModified);
+
+    // If the document was saved, discarding the history doesn't modify it.
+    manager.push(new QUndoCommand("Edit 3"), 0);
+    manager.undo();
+    REQUIRE(!manager.isModified());
+    manager.redo();
+    manager.setClean();
+    manager.push(new QUndoCommand("Edit 4"), 0);
+    manager.undo();
+    REQUIRE(!manager.isModified());
+    REQUIRE(!windowModified);
+}
+
+TEST_CASE("Actions/UndoManager/MemoryUsage", "")
+{
+    UndoManager manager;
+    manager.addNewUndoStack();
+    manager.setActiveStackIndex(0);
+    REQUIRE(manager.getMemoryUsage() == 0);
+
+    int numDiscarded = 0;
+    QObject::connect(&manager, &UndoManager::historyDiscarded,
+                     [&]() { ++numDiscarded; });
+    int numUsageChanges = 0;
+    QObject::connect(&manager, &UndoManager::memoryUsageChanged,
+                     [&]() { ++numUsageChanges; });
+
+    // Each command is wrapped by the undo manager, which adds some overhead.
+    manager.push(new TestCommand(1000), 0);
+    const size_t overhead = manager.getMemoryUsage() - 1000;
+    size_t expected = overhead + 1000;
+
+    manager.push(new TestCommand(2000), 0);
+    REQUIRE(manager.getMemoryUsage() == expected + overhead + 2000);
+
+    REQUIRE(numUsageChanges == 2);
+
+    // Pushing a command deletes the commands that were undone.
+    manager.undo();
+    REQUIRE(numUsageChanges == 2);
+    manager.push(new TestCommand(500), 0);
+    expected += overhead + 500;
+    REQUIRE(manager.getMemoryUsage() == expected);
+
+    // Merged commands are re-estimated.
+    manager.push(new TestCommand(100, true), 0);
+    manager.push(new TestCommand(200, true), 0);
+    expected += overhead + 300;
+    REQUIRE(manager.activeStack()->count() == 3);
+    REQUIRE(manager.getMemoryUsage() == expected);
+
+    // Macros are estimated once they are finished.
+    manager.beginMacro("Macro");
+    manager.push(new TestCommand(10), 0);
+    manager.push(new TestCommand(20), 0);
+    manager.endMacro();
+    expected += sizeof(QUndoCommand) + 2 * overhead + 30;
+    REQUIRE(manager.getMemoryUsage() == expected);
+    REQUIRE(numDiscarded == 0);
+
+    // Going over the limit discards the history, but the new command can still
+    // be undone.
+    manager.setMemoryLimit(expected - 1);
+    manager.push(new TestCommand(50), 0);
+    REQUIRE(numDiscarded == 1);
+    REQUIRE(manager.activeStack()->count() == 1);
+    REQUIRE(manager.activeStack()->canUndo());
+    REQUIRE(manager.getMemoryUsage() == overhead + 50);
+}
@@ -0,0 +1,69 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <app/caret.h>
+#include <app/viewoptions.h>
+#include <score/score.h>
+
+TEST_CASE("App/Caret/MoveToLocation", "")
+{
+    Score score;
+    System system;
+    system.insertStaff(Staff(6));
+    system.insertStaff(Staff(4));
+    score.insertSystem(system);
+    score.insertSystem(system);
+
+    ViewOptions options;
+    Caret caret(score, options);
+
+    SECTION("Valid location")
+    {
+        caret.moveToLocation(ScoreLocation(score, 1, 1, 5, 0, 3));
+        const ScoreLocation &location = caret.getLocation();
+        REQUIRE(location.getSystemIndex() == 1);
+        REQUIRE(location.getStaffIndex() == 1);
+        REQUIRE(location.getPositionIndex() == 5);
+        REQUIRE(location.getString() == 3);
+    }
+
+    SECTION("Location from an older version of the score")
+    {
+        // Staff 1 only has four strings, and the last position before the
+        // end bar is 29.
+        caret.moveToLocation(ScoreLocation(score, 1, 3, 40, 0, 5));
+        const ScoreLocation &location = caret.getLocation();
+        REQUIRE(location.getSystemIndex() == 1);
+        REQUIRE(location.getStaffIndex() == 1);
+        REQUIRE(location.getPositionIndex() == 29);
+        REQUIRE(location.getSelectionStart() == 29);
+        REQUIRE(location.getString() == 3);
+    }
+
+    SECTION("Removed system")
+    {
+        caret.moveToLocation(ScoreLocation(score, 0, 1, 10, 0, 2));
+        caret.moveToLocation(ScoreLocation(score, 2, 0, 5, 0, 0));
+        const ScoreLocation &location = caret.getLocation();
+        REQUIRE(location.getSystemIndex() == 0);
+        REQUIRE(location.getStaffIndex() == 1);
+        REQUIRE(location.getPositionIndex() == 10);
+        REQUIRE(location.getString() == 2);
+    }
+}
@@ -17,7 +17,13 @@
   
 #include <catch.hpp>
 
+#include <actions/scorechange.h>
 #include <app/documentmanager.h>
+#include <formats/bytereader.h>
+#include <formats/powertab/indexedfile.h>
+#include <midi/performanceorder.h>
+#include <score/utils/navigationindex.h>
+#include <sstream>
 
 TEST_CASE("App/DocumentManager", "")
 {
@@ -49,3 +55,99 @@ TEST_CASE("App/Document", "")
     REQUIRE(!document.hasFilename());
 }
 
+
+TEST_CASE("App/Document/NotifyChanged", "")
+{
+    Document document;
+    document.getScore().insertSystem(System());
+
+    uint64_t lastRevision = 0;
+    int numNotifications = 0;
+    document.getChangePubSub().subscribe(
+        [&](uint64_t revision, const ScoreChange &) {
+            lastRevision = revision;
+            ++numNotifications;
+        });
+
+    REQUIRE(document.getRevision() == 0);
+
+    auto index = document.getNavigationIndex();
+    REQUIRE(document.getNavigationIndex() == index);
+
+    // Editing a player doesn't affect the navigation index.
+    document.notifyChanged(ScoreChange::player(0));
+    REQUIRE(document.getRevision() == 1);
+    REQUIRE(lastRevision == 1);
+    REQUIRE(document.getNavigationIndex() == index);
+
+    // Empty changes are ignored.
+    document.notifyChanged(ScoreChange());
+    REQUIRE(document.getRevision() == 1);
+    REQUIRE(numNotifications == 1);
+
+    document.notifyChanged(ScoreChange::system(0));
+    REQUIRE(document.getRevision() == 2);
+    REQUIRE(lastRevision == 2);
+    REQUIRE(document.getNavigationIndex() != index);
+}
+
+TEST_CASE("App/Document/PlaybackTimeline", "")
+{
+    Document document;
+    document.getScore().insertSystem(System());
+
+    REQUIRE(!document.findPlaybackTimeline());
+
+    REQUIRE(document.updatePlaybackTimelineAsync());
+    auto timeline = document.getPlaybackTimeline();
+    REQUIRE(timeline);
+    REQUIRE(document.findPlaybackTimeline() == timeline);
+    REQUIRE(!document.updatePlaybackTimelineAsync());
+
+    // A result that finishes after the score was edited is discarded.
+    document.notifyChanged(ScoreChange::system(0));
+    REQUIRE(document.updatePlaybackTimelineAsync());
+    document.notifyChanged(ScoreChange::system(0));
+    REQUIRE(!document.findPlaybackTimeline());
+
+    auto newTimeline = document.getPlaybackTimeline();
+    REQUIRE(newTimeline);
+    REQUIRE(newTimeline != timeline);
+}
+
+TEST_CASE("App/Document/PerformanceOrder", "")
+{
+    Score original;
+    original.insertSystem(System());
+    original.insertSystem(System());
+
+    std::ostringstream output;
+    IndexedFile::save(output, original);
+    const std::string data = output.str();
+
+    Document document;
+    ByteReader reader(data.data(), data.size());
+    IndexedFile::load(reader, document.getScore());
+
+    // The order isn't computed on this thread until the systems are loaded.
+    REQUIRE(!document.findPerformanceOrder());
+    REQUIRE(document.getScore().getUnloadedSystemCount() == 2);
+
+    // The background computation of the timeline also provides the order.
+    REQUIRE(document.updatePlaybackTimelineAsync());
+    document.getPlaybackTimeline();
+    auto order = document.findPerformanceOrder();
+    REQUIRE(order);
+    REQUIRE(order->getBars().size() == 2);
+    REQUIRE(document.getScore().getUnloadedSystemCount() == 2);
+
+    // Once the systems are loaded, it can be computed directly.
+    document.notifyChanged(ScoreChange::system(0));
+    const Document &const_document = document;
+    for (const System &system : const_document.getScore().getSystems())
+        REQUIRE(system.getStaves().empty());
+
+    auto newOrder = document.findPerformanceOrder();
+    REQUIRE(newOrder);
+    REQUIRE(newOrder != order);
+}
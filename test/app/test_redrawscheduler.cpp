@@ -0,0 +1,91 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <app/redrawscheduler.h>
+#include <vector>
+
+TEST_CASE("App/RedrawScheduler", "")
+{
+    int systemCount = 10;
+    std::vector<int> redrawnSystems;
+    int fullRedraws = 0;
+
+    RedrawScheduler scheduler([&]() { return systemCount; },
+                              [&](int index) { redrawnSystems.push_back(index); },
+                              [&]() { ++fullRedraws; });
+
+    SECTION("Duplicate requests")
+    {
+        scheduler.requestSystemRedraw(3);
+        scheduler.requestSystemRedraw(1);
+        scheduler.requestSystemRedraw(3);
+        REQUIRE(scheduler.hasPendingRedraws());
+        REQUIRE(redrawnSystems.empty());
+
+        scheduler.flush();
+        REQUIRE(!scheduler.hasPendingRedraws());
+        REQUIRE(redrawnSystems == std::vector<int>({ 1, 3 }));
+        REQUIRE(fullRedraws == 0);
+
+        // Nothing is pending, so another flush should have no effect.
+        scheduler.flush();
+        REQUIRE(redrawnSystems.size() == 2);
+    }
+
+    SECTION("Full redraw")
+    {
+        scheduler.requestSystemRedraw(3);
+        scheduler.requestFullRedraw();
+        scheduler.requestSystemRedraw(4);
+
+        scheduler.flush();
+        REQUIRE(redrawnSystems.empty());
+        REQUIRE(fullRedraws == 1);
+    }
+
+    SECTION("Promote to full redraw")
+    {
+        for (int i = 0; i < 6; ++i)
+            scheduler.requestSystemRedraw(i);
+
+        scheduler.flush();
+        REQUIRE(redrawnSystems.empty());
+        REQUIRE(fullRedraws == 1);
+    }
+
+    SECTION("Removed systems")
+    {
+        scheduler.requestSystemRedraw(9);
+        systemCount = 5;
+
+        scheduler.flush();
+        REQUIRE(redrawnSystems.empty());
+        REQUIRE(fullRedraws == 1);
+    }
+
+    SECTION("Cancel")
+    {
+        scheduler.requestSystemRedraw(2);
+        scheduler.cancel();
+
+        scheduler.flush();
+        REQUIRE(redrawnSystems.empty());
+        REQUIRE(fullRedraws == 0);
+    }
+}
@@ -0,0 +1,359 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// Benchmarks for FileFormatManager::importFile.
+/// Each supported format is imported from a set of inputs, and the time and
+/// number of memory allocations per import are recorded. The results can be
+/// saved as a baseline, and later runs fail if they regress beyond a tolerance.
+
+#include "allocationcounter.h"
+#include "syntheticscore.h"
+
+#include <algorithm>
+#include <app/settingsmanager.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <formats/fileformatmanager.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <score/score.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+/// The measurements for one benchmark case.
+struct Result
+{
+    Result() : myAllocations(0), myTime(0) {}
+
+    /// The number of allocations made by a single import of the inputs.
+    size_t myAllocations;
+    /// The fastest time (in milliseconds) to import all of the inputs.
+    double myTime;
+};
+
+typedef std::map<std::string, Result> Results;
+
+struct BenchmarkCase
+{
+    /// e.g. "pt2/medium".
+    std::string myName;
+    FileFormat myFormat;
+    std::vector<fs::path> myInputs;
+};
+
+struct SyntheticSize
+{
+    const char *myName;
+    int myNumSystems;
+};
+
+const SyntheticSize theSyntheticSizes[] = {
+    { "small", 4 }, { "medium", 50 }, { "huge", 500 }
+};
+
+/// Formats that can be both exported and imported, which are benchmarked
+/// using synthetic scores.
+const char *const theRoundTripFormats[] = { "pt2" };
+
+/// Formats that can only be imported, which are benchmarked using the test
+/// suite's data files.
+const char *const theImportOnlyFormats[] = { "ptb", "gp5", "gpx" };
+}
+
+static Result runBenchmark(FileFormatManager &manager,
+                           const BenchmarkCase &benchmark, int iterations)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    Result result;
+    for (int i = 0; i < iterations; ++i)
+    {
+        const size_t allocations = getAllocationCount();
+        const auto start = Clock::now();
+
+        for (const fs::path &input : benchmark.myInputs)
+        {
+            Score score;
+            manager.importFile(score, input, benchmark.myFormat);
+        }
+
+        const double time =
+            std::chrono::duration<double, std::milli>(Clock::now() - start)
+                .count();
+
+        // The number of allocations should be the same for every iteration.
+        result.myAllocations = getAllocationCount() - allocations;
+        if (i == 0 || time < result.myTime)
+            result.myTime = time;
+    }
+
+    return result;
+}
+
+/// Generates the synthetic inputs for each of the round trip formats.
+static void addSyntheticCases(FileFormatManager &manager,
+                              const fs::path &workDir,
+                              std::vector<BenchmarkCase> &cases)
+{
+    for (const SyntheticSize &size : theSyntheticSizes)
+    {
+        Score score;
+        generateSyntheticScore(score, size.myNumSystems);
+
+        for (const char *extension : theRoundTripFormats)
+        {
+            const FileFormat format = *manager.findFormat(extension);
+            const fs::path path =
+                workDir / (std::string(size.myName) + "." + extension);
+            manager.exportFile(score, path, format);
+
+            BenchmarkCase benchmark = { std::string(extension) + "/" +
+                                            size.myName,
+                                        format,
+                                        { path } };
+            cases.push_back(benchmark);
+        }
+    }
+}
+
+/// Collects the test data files for each of the import-only formats.
+static void addDataFileCases(FileFormatManager &manager,
+                             const fs::path &dataDir,
+                             std::vector<BenchmarkCase> &cases)
+{
+    for (const char *extension : theImportOnlyFormats)
+    {
+        BenchmarkCase benchmark = { std::string(extension) + "/data",
+                                    *manager.findFormat(extension),
+                                    {} };
+
+        for (fs::directory_iterator it(dataDir), end; it != end; ++it)
+        {
+            if (it->path().extension() == std::string(".") + extension)
+                benchmark.myInputs.push_back(it->path());
+        }
+
+        std::sort(benchmark.myInputs.begin(), benchmark.myInputs.end());
+
+        if (benchmark.myInputs.empty())
+        {
+            std::cerr << "Warning: no ." << extension << " files found in "
+                      << dataDir << std::endl;
+        }
+        else
+            cases.push_back(benchmark);
+    }
+}
+
+/// Reads a baseline file, which has a line for each benchmark containing its
+/// name, number of allocations, and time.
+static Results readBaseline(const fs::path &path)
+{
+    fs::ifstream input(path);
+    if (!input)
+        throw std::runtime_error("Could not open " + path.string());
+
+    Results results;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream stream(line);
+        std::string name;
+        Result result;
+        if (!(stream >> name >> result.myAllocations >> result.myTime))
+            throw std::runtime_error("Invalid baseline entry: " + line);
+
+        results[name] = result;
+    }
+
+    return results;
+}
+
+static void writeBaseline(const fs::path &path, const Results &results)
+{
+    fs::ofstream output(path);
+    if (!output)
+        throw std::runtime_error("Could not open " + path.string());
+
+    output << "# name allocations time_ms" << std::endl;
+    for (const auto &entry : results)
+    {
+        output << entry.first << " " << entry.second.myAllocations << " "
+               << std::fixed << std::setprecision(3) << entry.second.myTime
+               << std::endl;
+    }
+}
+
+/// Returns whether the value exceeds the baseline by more than the tolerance.
+static bool isRegression(double value, double baseline, double tolerance)
+{
+    return value > baseline * (1 + tolerance);
+}
+
+int main(int argc, char *argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description desc(
+        "Usage: pte_import_benchmarks [options]\n"
+        "Measures the time and allocations for importing each file format.\n"
+        "\nOptions");
+
+    std::string dataDir;
+    std::string baselineFile;
+    std::string outputFile;
+    int iterations = 5;
+    double tolerance = 0.1;
+    bool checkTime = false;
+
+    try
+    {
+        desc.add_options()
+            ("help,h", "Displays this help.")
+            ("data-dir", po::value<std::string>(&dataDir),
+             "The directory containing the test data files. By default, this "
+             "is the 'data' directory next to the executable.")
+            ("iterations,n",
+             po::value<int>(&iterations)->default_value(iterations),
+             "The number of times to import each input. The fastest time is "
+             "reported.")
+            ("baseline", po::value<std::string>(&baselineFile),
+             "Compare the results against a baseline file, and fail if they "
+             "have regressed.")
+            ("write-baseline", po::value<std::string>(&outputFile),
+             "Save the results as a baseline file.")
+            ("tolerance",
+             po::value<double>(&tolerance)->default_value(tolerance),
+             "The allowed increase relative to the baseline (e.g. 0.1 for "
+             "10%).")
+            ("check-time", po::bool_switch(&checkTime),
+             "Also fail if the import times have regressed. Only the number "
+             "of allocations is checked by default, since timings depend on "
+             "the machine.");
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        po::notify(vm);
+        iterations = std::max(1, iterations);
+    }
+    catch (po::error &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (dataDir.empty())
+        dataDir = (fs::system_complete(argv[0]).parent_path() / "data").string();
+
+    SettingsManager settings;
+    FileFormatManager manager(settings);
+
+    const fs::path workDir =
+        fs::temp_directory_path() / fs::unique_path("pte-benchmarks-%%%%%%%%");
+    int numRegressions = 0;
+
+    try
+    {
+        fs::create_directories(workDir);
+
+        std::vector<BenchmarkCase> cases;
+        addSyntheticCases(manager, workDir, cases);
+        addDataFileCases(manager, dataDir, cases);
+
+        Results baseline;
+        if (!baselineFile.empty())
+            baseline = readBaseline(baselineFile);
+
+        Results results;
+        std::cout << std::left << std::setw(16) << "benchmark"
+                  << std::right << std::setw(8) << "files" << std::setw(14)
+                  << "allocations" << std::setw(12) << "time (ms)"
+                  << std::endl;
+
+        for (const BenchmarkCase &benchmark : cases)
+        {
+            const Result result = runBenchmark(manager, benchmark, iterations);
+            results[benchmark.myName] = result;
+
+            std::cout << std::left << std::setw(16) << benchmark.myName
+                      << std::right << std::setw(8) << benchmark.myInputs.size()
+                      << std::setw(14) << result.myAllocations << std::setw(12)
+                      << std::fixed << std::setprecision(2) << result.myTime;
+
+            auto it = baseline.find(benchmark.myName);
+            if (it != baseline.end())
+            {
+                const Result &expected = it->second;
+                if (isRegression(result.myAllocations, expected.myAllocations,
+                                 tolerance))
+                {
+                    std::cout << "  REGRESSION: expected at most "
+                              << expected.myAllocations << " allocations";
+                    ++numRegressions;
+                }
+                else if (checkTime && isRegression(result.myTime,
+                                                   expected.myTime, tolerance))
+                {
+                    std::cout << "  REGRESSION: expected at most "
+                              << expected.myTime << " ms";
+                    ++numRegressions;
+                }
+            }
+            else if (!baseline.empty())
+                std::cout << "  (no baseline)";
+
+            std::cout << std::endl;
+        }
+
+        if (!outputFile.empty())
+            writeBaseline(outputFile, results);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        numRegressions = -1;
+    }
+
+    boost::system::error_code ec;
+    fs::remove_all(workDir, ec);
+
+    if (numRegressions > 0)
+    {
+        std::cerr << numRegressions << " benchmark(s) regressed by more than "
+                  << tolerance * 100 << "%" << std::endl;
+    }
+
+    return numRegressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// Benchmarks for SystemRenderer.
+/// Synthetic scores are rendered in full (as when a document is opened), and
+/// a single system is repeatedly redrawn (as after each edit). The time and
+/// number of memory allocations are recorded for each case.
+
+#include "allocationcounter.h"
+#include "syntheticscore.h"
+
+#include <algorithm>
+#include <app/scorearea.h>
+#include <app/viewoptions.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <painters/systemrenderer.h>
+#include <QApplication>
+#include <QFontDatabase>
+#include <QGraphicsItem>
+#include <score/score.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// The measurements for one benchmark case.
+struct Result
+{
+    Result() : myAllocations(0), myTime(0) {}
+
+    /// The number of allocations made by a single run.
+    size_t myAllocations;
+    /// The fastest time (in milliseconds) for a run.
+    double myTime;
+};
+
+struct SyntheticSize
+{
+    const char *myName;
+    int myNumSystems;
+};
+
+const SyntheticSize theSyntheticSizes[] = {
+    { "small", 4 }, { "medium", 50 }, { "huge", 500 }
+};
+
+/// The number of times that a system is redrawn for the redraw benchmark.
+const int theNumRedraws = 20;
+}
+
+typedef std::vector<std::unique_ptr<QGraphicsItem>> ItemList;
+
+/// Runs the function several times, and records the fastest time and the
+/// number of allocations. The function adds the rendered systems to the item
+/// list, which are deleted afterwards outside of the measurements.
+template <typename RenderFn>
+static Result runBenchmark(int iterations, size_t numItems, RenderFn render)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    Result result;
+    for (int i = 0; i < iterations; ++i)
+    {
+        ItemList items;
+        items.reserve(numItems);
+
+        const size_t allocations = getAllocationCount();
+        const auto start = Clock::now();
+
+        render(items);
+
+        const double time =
+            std::chrono::duration<double, std::milli>(Clock::now() - start)
+                .count();
+
+        // The number of allocations should be the same for every iteration.
+        result.myAllocations = getAllocationCount() - allocations;
+        if (i == 0 || time < result.myTime)
+            result.myTime = time;
+    }
+
+    return result;
+}
+
+static void printResult(const std::string &name, int numSystems,
+                        const Result &result)
+{
+    std::cout << std::left << std::setw(16) << name << std::right
+              << std::setw(8) << numSystems << std::setw(14)
+              << result.myAllocations << std::setw(14)
+              << result.myAllocations / std::max(1, numSystems)
+              << std::setw(12) << std::fixed << std::setprecision(2)
+              << result.myTime << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description desc(
+        "Usage: pte_render_benchmarks [options]\n"
+        "Measures the time and allocations for rendering scores.\n"
+        "\nOptions");
+
+    int iterations = 5;
+
+    try
+    {
+        desc.add_options()
+            ("help,h", "Displays this help.")
+            ("iterations,n",
+             po::value<int>(&iterations)->default_value(iterations),
+             "The number of times to run each benchmark. The fastest time is "
+             "reported.");
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        po::notify(vm);
+        iterations = std::max(1, iterations);
+    }
+    catch (po::error &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    QApplication app(argc, argv);
+    QFontDatabase::addApplicationFont(":fonts/emmentaler-13.otf");
+    QFontDatabase::addApplicationFont(":fonts/LiberationSans-Regular.ttf");
+    QFontDatabase::addApplicationFont(":fonts/LiberationSerif-Regular.ttf");
+
+    ScoreArea scoreArea(nullptr);
+    const ViewOptions viewOptions;
+
+    std::cout << std::left << std::setw(16) << "benchmark" << std::right
+              << std::setw(8) << "systems" << std::setw(14) << "allocations"
+              << std::setw(14) << "per system" << std::setw(12) << "time (ms)"
+              << std::endl;
+
+    for (const SyntheticSize &size : theSyntheticSizes)
+    {
+        Score score;
+        generateSyntheticScore(score, size.myNumSystems);
+
+        // Render every system with the same renderer, as when a document is
+        // opened.
+        const Result result = runBenchmark(
+            iterations, score.getSystems().size(), [&](ItemList &items) {
+                SystemRenderer render(&scoreArea, score, viewOptions);
+                int i = 0;
+                for (const System &system : score.getSystems())
+                    items.emplace_back(render(system, i++));
+            });
+        printResult(std::string("render/") + size.myName, size.myNumSystems,
+                    result);
+    }
+
+    // Redraw a single system with a new renderer each time, as after an edit.
+    Score score;
+    generateSyntheticScore(score, 1);
+
+    const Result result =
+        runBenchmark(iterations, theNumRedraws, [&](ItemList &items) {
+            for (int i = 0; i < theNumRedraws; ++i)
+            {
+                SystemRenderer render(&scoreArea, score, viewOptions);
+                items.emplace_back(render(score.getSystems()[0], 0));
+            }
+        });
+    printResult("redraw", theNumRedraws, result);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "syntheticscore.h"
+
+#include <random>
+#include <score/score.h>
+
+static const int theNumStaves = 2;
+static const int theBarsPerSystem = 4;
+static const int thePositionsPerBar = 8;
+
+static Position generatePosition(std::mt19937 &rng, int index, int numStrings,
+                                 int maxNotes)
+{
+    Position pos(index, Position::EighthNote);
+
+    std::uniform_int_distribution<int> percent(0, 99);
+    if (percent(rng) < 10)
+    {
+        pos.setRest();
+        return pos;
+    }
+
+    if (percent(rng) < 20)
+        pos.setProperty(Position::PalmMuting);
+    if (percent(rng) < 10)
+        pos.setProperty(Position::LetRing);
+
+    std::uniform_int_distribution<int> numNotesDist(1, maxNotes);
+    std::uniform_int_distribution<int> fretDist(0, 12);
+
+    // Use distinct strings for each note in a chord.
+    const int numNotes = numNotesDist(rng);
+    const int firstString =
+        std::uniform_int_distribution<int>(0, numStrings - numNotes)(rng);
+
+    for (int i = 0; i < numNotes; ++i)
+    {
+        Note note(firstString + i, fretDist(rng));
+        if (percent(rng) < 10)
+            note.setProperty(Note::HammerOnOrPullOff);
+        pos.insertNote(note);
+    }
+
+    return pos;
+}
+
+void generateSyntheticScore(Score &score, int numSystems, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+
+    for (int i = 0; i < theNumStaves; ++i)
+    {
+        Player player;
+        player.setDescription("Player " + std::to_string(i + 1));
+        score.insertPlayer(player);
+
+        Instrument instrument;
+        instrument.setDescription("Instrument " + std::to_string(i + 1));
+        score.insertInstrument(instrument);
+    }
+
+    const int barWidth = thePositionsPerBar + 1;
+
+    for (int i = 0; i < numSystems; ++i)
+    {
+        System system;
+
+        for (int staffIndex = 0; staffIndex < theNumStaves; ++staffIndex)
+        {
+            const int numStrings = 6;
+            Staff staff(numStrings);
+            Voice &voice = staff.getVoices().front();
+
+            for (int bar = 0; bar < theBarsPerSystem; ++bar)
+            {
+                for (int j = 0; j < thePositionsPerBar; ++j)
+                {
+                    // Use chords in the first staff and single notes in the
+                    // second staff.
+                    voice.insertPosition(generatePosition(
+                        rng, bar * barWidth + j + 1, numStrings,
+                        staffIndex == 0 ? 3 : 1));
+                }
+            }
+
+            system.insertStaff(staff);
+        }
+
+        for (int bar = 1; bar < theBarsPerSystem; ++bar)
+            system.insertBarline(Barline(bar * barWidth, Barline::SingleBar));
+        system.getBarlines().back().setPosition(theBarsPerSystem * barWidth);
+
+        if (i % 4 == 0)
+        {
+            TempoMarker marker(0);
+            marker.setBeatsPerMinute(80 + 10 * (i % 8));
+            system.insertTempoMarker(marker);
+        }
+
+        if (i == 0)
+        {
+            PlayerChange change(0);
+            for (int staffIndex = 0; staffIndex < theNumStaves; ++staffIndex)
+            {
+                change.insertActivePlayer(
+                    staffIndex, ActivePlayer(staffIndex, staffIndex));
+            }
+            system.insertPlayerChange(change);
+        }
+
+        score.insertSystem(system);
+    }
+}
@@ -0,0 +1,31 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCHMARKS_SYNTHETICSCORE_H
+#define BENCHMARKS_SYNTHETICSCORE_H
+
+class Score;
+
+/// Fills the score with generated content for benchmarking.
+/// Each system contains several bars of notes, chords and rests across two
+/// staves, along with tempo markers and player changes. The content only
+/// depends on the number of systems and the seed, so that results are
+/// comparable between runs.
+void generateSyntheticScore(Score &score, int numSystems,
+                            unsigned int seed = 1);
+
+#endif
@@ -0,0 +1,87 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <app/appinfo.h>
+#include <app/settingsmanager.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <convert/batchconverter.h>
+#include <formats/fileformatmanager.h>
+#include <sstream>
+
+TEST_CASE("Convert/FindConversionInputs", "")
+{
+    SettingsManager settings;
+    FileFormatManager manager(settings);
+
+    const std::string ptb = AppInfo::getAbsolutePath("data/song_header.ptb");
+    const auto inputs = findConversionInputs(manager, { ptb }, false);
+    REQUIRE(inputs.size() == 1);
+    REQUIRE(inputs[0].myFile == ptb);
+
+    // Files that were named explicitly must still have an importer.
+    const std::string json =
+        AppInfo::getAbsolutePath("data/test_settingstree_expected.json");
+    REQUIRE_THROWS_AS(findConversionInputs(manager, { json }, false),
+                      std::runtime_error);
+
+    REQUIRE_THROWS_AS(
+        findConversionInputs(manager, { "missing_file.ptb" }, false),
+        std::runtime_error);
+}
+
+TEST_CASE("Convert/BatchConverter/OutputConflicts", "")
+{
+    namespace fs = boost::filesystem;
+
+    const fs::path dir =
+        fs::temp_directory_path() / fs::unique_path("pte-convert-%%%%%%%%");
+    fs::create_directories(dir);
+
+    // Both files would be converted to song.pt2.
+    std::vector<ConversionInput> inputs;
+    for (const char *name : { "song.gp5", "song.ptb" })
+    {
+        fs::ofstream(dir / name) << "data";
+        inputs.emplace_back(dir / name, dir);
+    }
+
+    SettingsManager settings;
+    BatchConverter::Options options;
+    options.myFormats = { "pt2", "pt2" };
+
+    std::ostringstream log;
+    BatchConverter converter(settings, options, log);
+    const int numFailures = converter.run(inputs);
+    const bool outputExists = fs::exists(dir / "song.pt2");
+    fs::remove_all(dir);
+
+    REQUIRE(numFailures == 2);
+    REQUIRE(!outputExists);
+
+    std::istringstream lines(log.str());
+    std::string line;
+    int numConflicts = 0;
+    while (std::getline(lines, line))
+    {
+        if (line.find("same output file") != std::string::npos)
+            ++numConflicts;
+    }
+    REQUIRE(numConflicts == 2);
+}
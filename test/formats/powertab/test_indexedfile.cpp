@@ -0,0 +1,195 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <formats/bytereader.h>
+#include <formats/fileformat.h>
+#include <formats/powertab/indexedfile.h>
+#include <score/score.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+static void createScore(Score &score, int numSystems)
+{
+    Player player;
+    player.setDescription("Player 1");
+    score.insertPlayer(player);
+    score.setLineSpacing(12);
+
+    for (int i = 0; i < numSystems; ++i)
+    {
+        System system;
+        Staff staff(6);
+        Position pos(i + 1);
+        pos.insertNote(Note(1, i));
+        staff.getVoices().front().insertPosition(pos);
+        system.insertStaff(staff);
+        score.insertSystem(system);
+    }
+}
+
+TEST_CASE("Formats/PowerTab/IndexedFile/LazyLoading", "")
+{
+    Score original;
+    createScore(original, 3);
+
+    std::ostringstream output;
+    IndexedFile::save(output, original);
+    const std::string data = output.str();
+
+    ByteReader reader(data.data(), data.size());
+    REQUIRE(IndexedFile::isIndexedFile(reader));
+
+    Score score;
+    IndexedFile::load(reader, score);
+
+    // Only the metadata is loaded up front.
+    REQUIRE(score.getPlayers().size() == 1);
+    REQUIRE(score.getLineSpacing() == 12);
+    REQUIRE(score.getSystems().size() == 3);
+    REQUIRE(score.getUnloadedSystemCount() == 3);
+
+    const System &system = score.getSystems()[1];
+    REQUIRE(score.getUnloadedSystemCount() == 2);
+    REQUIRE(system.getStaves()[0].getVoices()[0].getPositions()[0]
+                .getPosition() == 2);
+
+    // Inserting or removing systems doesn't load the other systems.
+    score.insertSystem(System(), 0);
+    REQUIRE(score.getSystems().size() == 4);
+    REQUIRE(score.getUnloadedSystemCount() == 2);
+    score.removeSystem(3);
+    REQUIRE(score.getUnloadedSystemCount() == 1);
+
+    score.insertSystem(original.getSystems()[2]);
+    score.removeSystem(0);
+    REQUIRE(score == original);
+    REQUIRE(score.getUnloadedSystemCount() == 0);
+}
+
+TEST_CASE("Formats/PowerTab/IndexedFile/LazyCopy", "")
+{
+    Score original;
+    createScore(original, 3);
+
+    std::ostringstream output;
+    IndexedFile::save(output, original);
+    const std::string data = output.str();
+
+    ByteReader reader(data.data(), data.size());
+    Score score;
+    IndexedFile::load(reader, score);
+
+    const Score &const_score = score;
+    const_score.getSystems()[0];
+
+    // Copying the score doesn't load the remaining systems, and each copy
+    // loads its own systems.
+    const Score copy(score);
+    REQUIRE(copy.getUnloadedSystemCount() == 2);
+    REQUIRE(&copy.getSystems()[0] == &const_score.getSystems()[0]);
+
+    copy.getSystems()[2];
+    REQUIRE(copy.getUnloadedSystemCount() == 1);
+    REQUIRE(score.getUnloadedSystemCount() == 2);
+
+    REQUIRE(copy == original);
+    REQUIRE(score == original);
+}
+
+TEST_CASE("Formats/PowerTab/IndexedFile/ConcurrentLoading", "")
+{
+    Score original;
+    createScore(original, 8);
+
+    std::ostringstream output;
+    IndexedFile::save(output, original);
+    const std::string data = output.str();
+
+    ByteReader reader(data.data(), data.size());
+    Score score;
+    IndexedFile::load(reader, score);
+
+    // Several threads may load the same systems at once, and each system is
+    // only published once.
+    const Score &const_score = score;
+    std::vector<const System *> loaded[4];
+    std::vector<std::thread> threads;
+    for (auto &systems : loaded)
+    {
+        threads.emplace_back([&]() {
+            for (const System &system : const_score.getSystems())
+                systems.push_back(&system);
+        });
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    REQUIRE(score.getUnloadedSystemCount() == 0);
+    for (auto &systems : loaded)
+    {
+        REQUIRE(systems.size() == 8);
+        for (size_t i = 0; i < systems.size(); ++i)
+            REQUIRE(systems[i] == &const_score.getSystems()[i]);
+    }
+
+    REQUIRE(score == original);
+}
+
+TEST_CASE("Formats/PowerTab/IndexedFile/InvalidData", "")
+{
+    Score original;
+    createScore(original, 2);
+
+    std::ostringstream output;
+    IndexedFile::save(output, original);
+    std::string data = output.str();
+
+    // Truncate the offset table.
+    {
+        ByteReader reader(data.data(), 20);
+        Score score;
+        REQUIRE_THROWS_AS(IndexedFile::load(reader, score),
+                          FileFormatException);
+    }
+
+    // Truncate the data blocks.
+    {
+        ByteReader reader(data.data(), data.size() - 10);
+        Score score;
+        REQUIRE_THROWS_AS(IndexedFile::load(reader, score),
+                          FileFormatException);
+    }
+
+    // Corrupt the last system's data. This is detected when the file is
+    // loaded, rather than when the system is accessed.
+    {
+        std::string corrupt = data;
+        corrupt[corrupt.size() - 12] ^= 0x55;
+
+        ByteReader reader(corrupt.data(), corrupt.size());
+        Score score;
+        REQUIRE_THROWS_AS(IndexedFile::load(reader, score),
+                          FileFormatException);
+    }
+
+    const char other[] = "not an indexed file";
+    REQUIRE(!IndexedFile::isIndexedFile(ByteReader(other, sizeof(other))));
+}
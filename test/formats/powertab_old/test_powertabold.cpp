@@ -21,6 +21,7 @@
 #include <formats/powertab/powertabimporter.h>
 #include <formats/powertab_old/powertaboldimporter.h>
 #include <formats/powertab_old/powertabdocument/powertabdocument.h>
+#include <formats/powertab_old/powertabdocument/powertabinputstream.h>
 #include <score/score.h>
 
 static void loadTest(FileFormatImporter &importer, const char *filename,
@@ -379,3 +380,19 @@ TEST_CASE("Formats/PowerTabOldImport/MergeMultiBarRests", "")
 
     REQUIRE(score == expected_score);
 }
+
+TEST_CASE("Formats/PowerTabOldImport/InvalidData", "")
+{
+    // An array that is larger than its maximum size.
+    const char data[] = { 3, 1, 2, 3 };
+    PowerTabDocument::PowerTabInputStream stream(ByteReader(data, sizeof(data)));
+
+    std::array<uint8_t, 2> array;
+    REQUIRE_THROWS_AS(stream.ReadSmallVector(array), FileFormatException);
+
+    // A file that doesn't have a valid header.
+    const char header[] = "not a power tab file";
+    PowerTabDocument::Document document;
+    REQUIRE_THROWS_AS(document.Load(ByteReader(header, sizeof(header)), "test"),
+                      FileFormatException);
+}
@@ -0,0 +1,61 @@
+/*
+  * Copyright (C) 2013 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <catch.hpp>
+
+#include <formats/bytereader.h>
+#include <formats/fileformat.h>
+
+TEST_CASE("Formats/ByteReader/LittleEndian", "")
+{
+    const char data[] = { 0x01, 0x02, 0x03, 0x04, static_cast<char>(0xff),
+                          0x01 };
+    ByteReader reader(data, sizeof(data));
+
+    REQUIRE(reader.read<uint32_t>() == 0x04030201u);
+    REQUIRE(reader.read<int8_t>() == -1);
+    REQUIRE(reader.read<bool>());
+    REQUIRE(reader.atEnd());
+}
+
+TEST_CASE("Formats/ByteReader/Strings", "")
+{
+    const char data[] = "abcdef";
+    ByteReader reader(data, 6);
+
+    reader.skip(1);
+    REQUIRE(reader.readString(3) == "bcd");
+    REQUIRE(reader.position() == 4);
+
+    reader.seek(0);
+    REQUIRE(reader.readString(2) == "ab");
+}
+
+TEST_CASE("Formats/ByteReader/BoundsChecking", "")
+{
+    const char data[] = { 0x01, 0x02, 0x03 };
+    ByteReader reader(data, sizeof(data));
+
+    REQUIRE_THROWS_AS(reader.read<uint32_t>(), FileFormatException);
+    REQUIRE(reader.read<uint16_t>() == 0x0201);
+    REQUIRE_THROWS_AS(reader.readString(2), FileFormatException);
+    REQUIRE_THROWS_AS(reader.seek(4), FileFormatException);
+
+    // Skipping past the end is only an error once something is read.
+    reader.skip(10);
+    REQUIRE(reader.atEnd());
+    REQUIRE_THROWS_AS(reader.read<uint8_t>(), FileFormatException);
+}
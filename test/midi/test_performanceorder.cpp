@@ -0,0 +1,57 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <midi/performanceorder.h>
+#include <score/score.h>
+
+TEST_CASE("Midi/PerformanceOrder", "")
+{
+    Score score;
+    System system;
+    system.insertBarline(Barline(10, Barline::RepeatEnd, 2));
+    score.insertSystem(system);
+    score.insertSystem(System());
+
+    PerformanceOrder order(score);
+    auto &bars = order.getBars();
+
+    REQUIRE(bars.size() == 4);
+
+    REQUIRE(bars[0].myLocation == SystemLocation(0, 0));
+    REQUIRE(bars[0].myEndPosition == 10);
+    REQUIRE(bars[0].myRepeatNumber == 1);
+    REQUIRE(!bars[0].myIsJump);
+
+    REQUIRE(bars[1].myLocation == SystemLocation(0, 0));
+    REQUIRE(bars[1].myRepeatNumber == 2);
+    REQUIRE(bars[1].myIsJump);
+
+    REQUIRE(bars[2].myLocation == SystemLocation(0, 10));
+    REQUIRE(bars[2].myEndPosition == 30);
+    REQUIRE(!bars[2].myIsJump);
+
+    REQUIRE(bars[3].myLocation == SystemLocation(1, 0));
+    REQUIRE(!bars[3].myIsJump);
+
+    REQUIRE(order.findBarIndices(SystemLocation(0, 5)) ==
+            std::vector<int>({ 0, 1 }));
+    REQUIRE(order.findFirstBarIndex(SystemLocation(0, 12)) == 2);
+    REQUIRE(order.findFirstBarIndex(SystemLocation(1, 30)) == 3);
+    REQUIRE(order.findFirstBarIndex(SystemLocation(2, 0)) == -1);
+}
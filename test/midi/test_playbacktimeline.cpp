@@ -0,0 +1,66 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <midi/midifile.h>
+#include <midi/performanceorder.h>
+#include <midi/playbacktimeline.h>
+#include <score/score.h>
+
+TEST_CASE("Midi/PlaybackTimeline", "")
+{
+    Score score;
+    System system;
+    system.insertBarline(Barline(10, Barline::RepeatEnd, 2));
+    TempoMarker marker(10);
+    marker.setBeatsPerMinute(60);
+    system.insertTempoMarker(marker);
+    score.insertSystem(system);
+    score.insertSystem(System());
+
+    PerformanceOrder order(score);
+    MidiFile file;
+    file.load(score, order, MidiFile::LoadOptions());
+
+    // Each bar is in 4/4 time. The first bar is repeated at 120bpm, and the
+    // remaining bars are at 60bpm.
+    PlaybackTimeline timeline(order, file);
+    REQUIRE(timeline.getDuration() == 12000000);
+
+    REQUIRE(timeline.getBarStartTime(0) == 0);
+    REQUIRE(timeline.getBarStartTime(1) == 2000000);
+    REQUIRE(timeline.getBarStartTime(2) == 4000000);
+    REQUIRE(timeline.getBarStartTime(3) == 8000000);
+
+    REQUIRE(timeline.getTick(timeline.getTime(2500)) == 2500);
+    REQUIRE(timeline.getTick(timeline.getTime(5000)) == 5000);
+
+    REQUIRE(timeline.findBarIndex(0) == 0);
+    REQUIRE(timeline.findBarIndex(3000000) == 1);
+    REQUIRE(timeline.findBarIndex(7999999) == 2);
+    REQUIRE(timeline.findBarIndex(20000000) == 3);
+
+    REQUIRE(timeline.findLocation(3000000) == SystemLocation(0, 0));
+    REQUIRE(timeline.findLocation(5000000) == SystemLocation(0, 10));
+    REQUIRE(timeline.findLocation(9000000) == SystemLocation(1, 0));
+
+    // The second pass through the repeated bar.
+    auto bars = order.findBarIndices(SystemLocation(0, 0));
+    REQUIRE(bars.size() == 2);
+    REQUIRE(timeline.findTime(bars[1], SystemLocation(0, 0)) == 2000000);
+}
@@ -0,0 +1,44 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <boost/rational.hpp>
+#include <midi/temposcale.h>
+
+TEST_CASE("Midi/TempoScale/GetTime", "")
+{
+    TempoScale tempo(500000, 480);
+    REQUIRE(tempo.getBeatDuration() == 500000);
+    REQUIRE(tempo.getTicksPerBeat() == 480);
+    REQUIRE(tempo.getTime(480) == 500000);
+    REQUIRE(tempo.getTime(0) == 0);
+
+    // Compare against the previous calculation with boost::rational.
+    const int tempos[] = { 500000, 428571, 1000000, 333333, 60000000 / 97 };
+    for (int beat_duration : tempos)
+    {
+        tempo.setBeatDuration(beat_duration);
+
+        for (int ticks = 0; ticks < 2000; ticks += 7)
+        {
+            REQUIRE(tempo.getTime(ticks) ==
+                    boost::rational_cast<int>(
+                        boost::rational<int>(ticks, 480) * beat_duration));
+        }
+    }
+}
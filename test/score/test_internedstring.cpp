@@ -0,0 +1,57 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <score/internedstring.h>
+#include <string>
+
+TEST_CASE("Score/InternedString/Sharing", "")
+{
+    const size_t poolSize = InternedString::getPoolSize();
+
+    {
+        InternedString a(std::string("Rhythm Guitar 1"));
+        InternedString b("Rhythm Guitar 1");
+        InternedString c("Rhythm Guitar 2");
+
+        REQUIRE(a.str() == "Rhythm Guitar 1");
+        REQUIRE(a == b);
+        REQUIRE(&a.str() == &b.str());
+        REQUIRE(a != c);
+        REQUIRE(InternedString::Hash()(a) == InternedString::Hash()(b));
+        REQUIRE(InternedString::getPoolSize() == poolSize + 2);
+
+        InternedString copy = a;
+        REQUIRE(&copy.str() == &a.str());
+        REQUIRE(InternedString::getPoolSize() == poolSize + 2);
+    }
+
+    // The strings are released once they are no longer used.
+    REQUIRE(InternedString::getPoolSize() == poolSize);
+}
+
+TEST_CASE("Score/InternedString/Empty", "")
+{
+    InternedString empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty == InternedString(""));
+    REQUIRE(empty != InternedString("a"));
+
+    const std::string &str = empty;
+    REQUIRE(str.empty());
+}
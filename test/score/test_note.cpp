@@ -108,6 +108,28 @@ TEST_CASE("Score/Note/LeftHandFingering", "")
     REQUIRE(!note.hasLeftHandFingering());
 }
 
+TEST_CASE("Score/Note/RareProperties", "")
+{
+    Note note(1, 5);
+    note.setBend(Bend(Bend::NormalBend, 4));
+    note.setLeftHandFingering(LeftHandFingering(LeftHandFingering::Ring));
+
+    // Copies should not share the bend, fingering, etc.
+    Note copy(note);
+    copy.clearBend();
+    REQUIRE(note.hasBend());
+    REQUIRE(!copy.hasBend());
+    REQUIRE(copy.hasLeftHandFingering());
+    REQUIRE(copy.getLeftHandFingering().getFingerNumber() == 3);
+
+    copy.clearLeftHandFingering();
+    REQUIRE(copy == Note(1, 5));
+
+    copy = note;
+    REQUIRE(copy == note);
+    REQUIRE(copy.getBend() == note.getBend());
+}
+
 TEST_CASE("Score/Note/Bend/GetPitchText", "")
 {
     REQUIRE(Bend::getPitchText(0) == "Standard");
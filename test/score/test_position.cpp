@@ -64,6 +64,21 @@ TEST_CASE("Score/Position/Notes", "")
     REQUIRE(position.getNotes()[0] == note2);
 }
 
+TEST_CASE("Score/Position/LargeChord", "")
+{
+    // Check that more notes can be added than are stored inline.
+    Position position;
+    for (int string = 7; string >= 0; --string)
+        position.insertNote(Note(string, string + 1));
+
+    REQUIRE(position.getNotes().size() == 8);
+    for (int string = 0; string < 8; ++string)
+        REQUIRE(position.getNotes()[string] == Note(string, string + 1));
+
+    Position copy(position);
+    REQUIRE(copy == position);
+}
+
 TEST_CASE("Score/Position/FindByString", "")
 {
     Position position;
@@ -18,6 +18,7 @@
 #include <catch.hpp>
 
 #include <score/score.h>
+#include <score/scorelocation.h>
 
 TEST_CASE("Score/Score/Systems", "")
 {
@@ -77,3 +78,91 @@ TEST_CASE("Score/Score/ViewFilters", "")
     REQUIRE(score.getViewFilters().size() == 1);
     REQUIRE(score.getViewFilters()[0] == filter1);
 }
+
+TEST_CASE("Score/Score/Copy", "")
+{
+    Score score;
+    score.insertSystem(System());
+    score.insertSystem(System());
+
+    Score copy(score);
+    REQUIRE(copy == score);
+
+    // Unmodified systems are shared between the copies.
+    const Score &const_score = score;
+    const Score &const_copy = copy;
+    REQUIRE(&const_copy.getSystems()[0] == &const_score.getSystems()[0]);
+
+    // Modifying a system only affects one of the copies.
+    copy.getSystems()[1].insertBarline(Barline(10, Barline::SingleBar));
+    REQUIRE(const_copy.getSystems()[1].getBarlines().size() == 3);
+    REQUIRE(const_score.getSystems()[1].getBarlines().size() == 2);
+    REQUIRE(&const_copy.getSystems()[0] == &const_score.getSystems()[0]);
+    REQUIRE(!(copy == score));
+
+    score = copy;
+    REQUIRE(copy == score);
+    REQUIRE(&const_copy.getSystems()[1] == &const_score.getSystems()[1]);
+}
+
+TEST_CASE("Score/Score/CopyAndEditPosition", "")
+{
+    Score score;
+    System system;
+    system.insertStaff(Staff());
+    system.getStaves()[0].getVoices()[0].insertPosition(Position(5));
+    score.insertSystem(system);
+
+    const Score copy(score);
+    const uint64_t hash = copy.getSystems()[0].getContentHash();
+
+    // Modifying a position through a location detaches the system from the
+    // other copy of the score.
+    ScoreLocation location(score, 0, 0, 5);
+    location.getPosition()->setDurationType(Position::HalfNote);
+
+    REQUIRE(copy.getSystems()[0]
+                .getStaves()[0]
+                .getVoices()[0]
+                .getPositions()[0]
+                .getDurationType() == Position::EighthNote);
+    REQUIRE(copy.getSystems()[0].getContentHash() == hash);
+
+    const Score &const_score = score;
+    REQUIRE(const_score.getSystems()[0].getContentHash() != hash);
+}
+
+TEST_CASE("Score/Score/CopyAndEditSelection", "")
+{
+    Score score;
+    System system;
+    system.insertStaff(Staff());
+    Position pos(5);
+    pos.insertNote(Note(2, 3));
+    system.getStaves()[0].getVoices()[0].insertPosition(pos);
+    system.getStaves()[0].getVoices()[0].insertPosition(Position(6));
+    score.insertSystem(system);
+
+    const Score copy(score);
+    const Voice &copy_voice =
+        copy.getSystems()[0].getStaves()[0].getVoices()[0];
+
+    // Editing notes or selected positions through a location also detaches
+    // the system from the other copy of the score.
+    ScoreLocation location(score, 0, 0, 5, 0, 2);
+    location.getNote()->setFretNumber(7);
+    REQUIRE(copy_voice.getPositions()[0].getNotes()[0].getFretNumber() == 3);
+
+    const Score copy2(score);
+    location.setSelectionStart(6);
+    for (Position *selected : location.getSelectedPositions())
+        selected->setDurationType(Position::HalfNote);
+
+    for (const Position &p : copy2.getSystems()[0]
+                                 .getStaves()[0]
+                                 .getVoices()[0]
+                                 .getPositions())
+    {
+        REQUIRE(p.getDurationType() == Position::EighthNote);
+    }
+}
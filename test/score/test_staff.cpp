@@ -130,3 +130,31 @@ TEST_CASE("Score/Staff/GetNextNote", "")
     REQUIRE(!VoiceUtils::getPreviousNote(voice, 6, 2));
     REQUIRE(VoiceUtils::getPreviousNote(voice, 6, 3));
 }
+
+TEST_CASE("Score/Staff/ContentHash", "")
+{
+    Staff staff(6);
+    const uint64_t original = staff.getContentHash();
+    REQUIRE(Staff(7).getContentHash() != original);
+
+    Position pos(1);
+    pos.insertNote(Note(2, 3));
+    staff.getVoices()[1].insertPosition(pos);
+    const uint64_t modified = staff.getContentHash();
+    REQUIRE(modified != original);
+
+    staff.getVoices()[1].getPositions()[0].getNotes()[0].setFretNumber(4);
+    REQUIRE(staff.getContentHash() != modified);
+
+    staff.setClefType(Staff::BassClef);
+    REQUIRE(staff.getContentHash() != modified);
+
+    // The voices are in a different order.
+    Staff swapped(6);
+    swapped.setClefType(Staff::BassClef);
+    Position other_pos(1);
+    other_pos.insertNote(Note(2, 4));
+    swapped.getVoices()[0].insertPosition(other_pos);
+    REQUIRE(swapped.getContentHash() != staff.getContentHash());
+    REQUIRE(!(swapped == staff));
+}
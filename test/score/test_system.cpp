@@ -203,3 +203,74 @@ TEST_CASE("Score/System/TextItems", "")
     REQUIRE(system.getTextItems().size() == 1);
     REQUIRE(system.getTextItems()[0] == text1);
 }
+
+TEST_CASE("Score/System/Shift", "")
+{
+    System system;
+    system.insertBarline(Barline(6, Barline::SingleBar));
+    system.insertTextItem(TextItem(2, "foo"));
+    system.insertTextItem(TextItem(5, "bar"));
+
+    Staff staff(6);
+    staff.getVoices()[0].insertPosition(Position(4));
+    staff.getVoices()[0].insertPosition(Position(8));
+    system.insertStaff(staff);
+
+    SystemUtils::shift(system, 4, 3);
+    REQUIRE(system.getBarlines()[0].getPosition() == 0);
+    REQUIRE(system.getBarlines()[1].getPosition() == 9);
+    REQUIRE(system.getTextItems()[0].getPosition() == 2);
+    REQUIRE(system.getTextItems()[1].getPosition() == 8);
+    const Voice &voice = system.getStaves()[0].getVoices()[0];
+    REQUIRE(voice.getPositions()[0].getPosition() == 7);
+    REQUIRE(voice.getPositions()[1].getPosition() == 11);
+
+    SystemUtils::shift(system, 4, -3);
+    REQUIRE(system.getBarlines()[1].getPosition() == 6);
+    REQUIRE(system.getTextItems()[1].getPosition() == 5);
+    REQUIRE(voice.getPositions()[0].getPosition() == 4);
+    REQUIRE(voice.getPositions()[1].getPosition() == 8);
+}
+
+TEST_CASE("Score/System/ContentHash", "")
+{
+    System system;
+    system.insertStaff(Staff());
+
+    const uint64_t original = system.getContentHash();
+    REQUIRE(System().getContentHash() != original);
+
+    // Copies have the same hash.
+    System copy(system);
+    REQUIRE(copy.getContentHash() == original);
+
+    system.insertBarline(Barline(10, Barline::SingleBar));
+    const uint64_t modified = system.getContentHash();
+    REQUIRE(modified != original);
+
+    // Changes to a staff are detected, even if the staff was accessed
+    // before the system's hash was computed.
+    Staff &staff = system.getStaves()[0];
+    REQUIRE(system.getContentHash() == modified);
+    staff.getVoices()[0].insertPosition(Position(3));
+    REQUIRE(system.getContentHash() != modified);
+
+    // The hash depends only on the contents of the system.
+    staff.getVoices()[0].removePosition(Position(3));
+    REQUIRE(system.getContentHash() == modified);
+    system.removeBarline(Barline(10, Barline::SingleBar));
+    REQUIRE(system.getContentHash() == original);
+
+    // Player changes and text are included.
+    PlayerChange change(5);
+    change.insertActivePlayer(0, ActivePlayer(1, 2));
+    system.insertPlayerChange(change);
+    const uint64_t with_players = system.getContentHash();
+    REQUIRE(with_players != original);
+
+    system.getPlayerChanges()[0].insertActivePlayer(0, ActivePlayer(2, 2));
+    REQUIRE(system.getContentHash() != with_players);
+
+    system.insertTextItem(TextItem(3, "text"));
+    REQUIRE(system.getContentHash() != with_players);
+}
@@ -0,0 +1,78 @@
+/*
+  * Copyright (C) 2017 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+  
+#include <catch.hpp>
+
+#include <score/ticks.h>
+#include <score/voicedurations.h>
+#include <score/voice.h>
+#include <score/voiceutils.h>
+
+TEST_CASE("Score/Ticks/Conversions", "")
+{
+    REQUIRE(Ticks::fromRational(1) == Ticks::PER_QUARTER);
+    REQUIRE(Ticks::fromRational(boost::rational<int>(1, 3)) * 3 ==
+            Ticks::PER_QUARTER);
+    REQUIRE(Ticks::toRational(Ticks::PER_QUARTER / 2) ==
+            boost::rational<int>(1, 2));
+    REQUIRE(Ticks::convert(Ticks::PER_QUARTER / 3, 480) == 160);
+}
+
+/// Compare against the durations computed with boost::rational for every
+/// combination of note length, dots, and irregular grouping.
+TEST_CASE("Score/Ticks/MatchesRationalDurations", "")
+{
+    const Position::DurationType durations[] = {
+        Position::WholeNote,        Position::HalfNote,
+        Position::QuarterNote,      Position::EighthNote,
+        Position::SixteenthNote,    Position::ThirtySecondNote,
+        Position::SixtyFourthNote
+    };
+
+    for (Position::DurationType type : durations)
+    {
+        for (int dots = 0; dots < 3; ++dots)
+        {
+            for (int played = 2; played <= 16; ++played)
+            {
+                for (int playedOver = 1; playedOver <= 8; ++playedOver)
+                {
+                    Position pos(0, type);
+                    if (dots == 1)
+                        pos.setProperty(Position::Dotted);
+                    else if (dots == 2)
+                        pos.setProperty(Position::DoubleDotted);
+
+                    Voice voice;
+                    voice.insertPosition(pos);
+                    voice.insertIrregularGrouping(
+                        IrregularGrouping(0, 1, played, playedOver));
+
+                    // A copy of the position isn't part of the voice, so its
+                    // duration is computed using boost::rational.
+                    const boost::rational<int> expected =
+                        VoiceUtils::getDurationTime(voice, pos);
+                    const int64_t ticks = voice.getDurations()->getDuration(0);
+
+                    REQUIRE(Ticks::toRational(ticks) == expected);
+                    REQUIRE(Ticks::convert(ticks, 480) ==
+                            boost::rational_cast<int>(480 * expected));
+                }
+            }
+        }
+    }
+}
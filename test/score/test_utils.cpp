@@ -17,9 +17,19 @@
   
 #include <catch.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <score/score.h>
 #include <score/system.h>
+#include <score/ticks.h>
 #include <score/utils.h>
+#include <score/utils/memoryusage.h>
+#include <score/utils/navigationindex.h>
+#include <score/utils/parallelsystems.h>
+#include <score/utils/scorepolisher.h>
+#include <score/utils/scoreview.h>
+#include <stdexcept>
+#include <thread>
 
 TEST_CASE("Score/Utils/FindByPosition", "")
 {
@@ -33,6 +43,26 @@ TEST_CASE("Score/Utils/FindByPosition", "")
     REQUIRE(*ScoreUtils::findByPosition(system.getBarlines(), 42) == barline);
 }
 
+TEST_CASE("Score/Utils/InsertObjects", "")
+{
+    Voice voice;
+    voice.insertPosition(Position(2));
+    voice.insertPosition(Position(6));
+
+    // The new positions are unsorted and overlap with the existing ones.
+    voice.insertPositions({ Position(7), Position(1), Position(4) });
+
+    std::vector<int> positions;
+    for (const Position &pos : voice.getPositions())
+        positions.push_back(pos.getPosition());
+    REQUIRE(positions == std::vector<int>({ 1, 2, 4, 6, 7 }));
+
+    voice.insertPositions({ Position(9), Position(8) });
+    REQUIRE(voice.getPositions().size() == 7);
+    REQUIRE(voice.getPositions()[5].getPosition() == 8);
+    REQUIRE(voice.getPositions()[6].getPosition() == 9);
+}
+
 TEST_CASE("Score/Utils/GetCurrentPlayers", "")
 {
     Score score;
@@ -47,3 +77,222 @@ TEST_CASE("Score/Utils/GetCurrentPlayers", "")
     REQUIRE(ScoreUtils::getCurrentPlayers(score, 0, 7));
     REQUIRE(ScoreUtils::getCurrentPlayers(score, 1, 0));
 }
+
+TEST_CASE("Score/Utils/NavigationIndex", "")
+{
+    Score score;
+    {
+        System system;
+        Barline barline(10, Barline::SingleBar);
+        barline.setRehearsalSign(RehearsalSign("A", "Intro"));
+        system.insertBarline(barline);
+        score.insertSystem(system);
+    }
+    {
+        System system;
+        Barline barline(20, Barline::SingleBar);
+        barline.setRehearsalSign(RehearsalSign("B", "Verse"));
+        system.insertBarline(barline);
+        score.insertSystem(system);
+    }
+
+    NavigationIndex index(score);
+
+    REQUIRE(index.getBarCount() == 4);
+    REQUIRE(index.getBarLocation(1) == SystemLocation(0, 0));
+    REQUIRE(index.getBarLocation(2) == SystemLocation(0, 10));
+    REQUIRE(index.getBarLocation(3) == SystemLocation(1, 0));
+    REQUIRE(index.getBarLocation(4) == SystemLocation(1, 20));
+
+    REQUIRE(index.findBarNumber(SystemLocation(0, 5)) == 1);
+    REQUIRE(index.findBarNumber(SystemLocation(0, 10)) == 2);
+    REQUIRE(index.findBarNumber(SystemLocation(1, 25)) == 4);
+
+    REQUIRE(index.getRehearsalSigns().size() == 2);
+    REQUIRE(index.getRehearsalSigns()[1].myDescription == "Verse");
+    REQUIRE(index.findRehearsalSign("B")->myLocation ==
+            SystemLocation(1, 20));
+    REQUIRE(!index.findRehearsalSign("C"));
+}
+
+TEST_CASE("Score/Utils/MeasureMemory", "")
+{
+    Score score;
+    System system;
+    Staff staff(6);
+    Position pos(0);
+    pos.insertNote(Note(1, 5));
+    pos.insertNote(Note(2, 7));
+    staff.getVoices()[0].insertPosition(pos);
+    system.insertStaff(staff);
+    score.insertSystem(system);
+
+    const ScoreUtils::MemoryUsage usage = ScoreUtils::measureMemory(score);
+    REQUIRE(usage.myNotes == 2 * sizeof(Note));
+    REQUIRE(usage.myPositions + usage.myNotes >= sizeof(Position));
+    REQUIRE(usage.myStaves >= sizeof(Staff));
+    REQUIRE(usage.mySystems >= sizeof(System));
+    REQUIRE(usage.getTotal() ==
+            usage.myScore + ScoreUtils::estimateMemoryUsage(system));
+
+    // Bends are stored separately from the note.
+    System &scoreSystem = score.getSystems()[0];
+    Note &note = scoreSystem.getStaves()[0].getVoices()[0].getPositions()[0]
+                     .getNotes()[0];
+    note.setBend(Bend(Bend::NormalBend, 4));
+    REQUIRE(ScoreUtils::measureMemory(score).myNotes > usage.myNotes);
+}
+
+TEST_CASE("Score/Utils/PolishScore", "")
+{
+    Score score;
+    for (int i = 0; i < 20; ++i)
+    {
+        System system;
+        system.insertBarline(Barline(16, Barline::SingleBar));
+
+        Staff staff(6);
+        Voice &voice1 = staff.getVoices()[0];
+        Position grace(3 + i % 4, Position::EighthNote);
+        grace.setProperty(Position::Acciaccatura);
+        voice1.insertPosition(grace);
+        voice1.insertPosition(Position(8, Position::QuarterNote));
+        voice1.insertPosition(Position(20 + i % 5, Position::HalfNote));
+        voice1.insertPosition(Position(25, Position::WholeNote));
+        staff.getVoices()[1].insertPosition(
+            Position(12 - i % 3, Position::EighthNote));
+        system.insertStaff(staff);
+        score.insertSystem(system);
+    }
+
+    // Polishing the systems concurrently should give the same results as
+    // polishing them one at a time.
+    std::vector<System> expected;
+    for (const System &system : score.getSystems())
+    {
+        expected.push_back(system);
+        ScoreUtils::polishSystem(expected.back());
+    }
+
+    ScoreUtils::ParallelOptions options;
+    options.myNumThreads = 4;
+    int lastProgress = -1;
+    options.myProgress = [&](int completed, int total) {
+        REQUIRE(completed > lastProgress);
+        REQUIRE(total == 20);
+        lastProgress = completed;
+        return true;
+    };
+
+    REQUIRE(ScoreUtils::polishScore(score, options));
+    REQUIRE(lastProgress == 20);
+
+    for (int i = 0; i < 20; ++i)
+        REQUIRE(score.getSystems()[i] == expected[i]);
+}
+
+TEST_CASE("Score/Utils/ForEachSystem", "")
+{
+    Score score;
+    for (int i = 0; i < 100; ++i)
+        score.insertSystem(System());
+
+    SECTION("Exceptions")
+    {
+        ScoreUtils::ParallelOptions options;
+        options.myNumThreads = 1;
+
+        std::vector<int> visited;
+        REQUIRE_THROWS_AS(ScoreUtils::forEachSystem(
+                              score,
+                              [&](int i, System &) {
+                                  visited.push_back(i);
+                                  if (i == 2)
+                                      throw std::runtime_error("error");
+                              },
+                              options),
+                          std::runtime_error);
+
+        REQUIRE(visited == std::vector<int>({ 0, 1, 2 }));
+    }
+
+    SECTION("Cancel")
+    {
+        std::atomic<bool> started(false);
+        std::atomic<int> count(0);
+
+        ScoreUtils::ParallelOptions options;
+        options.myNumThreads = 2;
+        options.myProgress = [&](int, int) {
+            started = true;
+            return false;
+        };
+
+        // Process the systems slowly, so that the cancellation is noticed
+        // long before all of the systems are finished.
+        REQUIRE(!ScoreUtils::forEachSystem(
+            score,
+            [&](int, System &) {
+                while (!started)
+                    std::this_thread::yield();
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                ++count;
+            },
+            options));
+
+        REQUIRE(count < 100);
+    }
+}
+
+TEST_CASE("Score/Utils/ScoreView", "")
+{
+    Score score;
+    {
+        System system;
+        Staff staff(6);
+        Position pos1(3, Position::QuarterNote);
+        pos1.insertNote(Note(2, 5));
+        pos1.insertNote(Note(4, 7));
+        staff.getVoices()[0].insertPosition(pos1);
+        Position pos2(8, Position::EighthNote);
+        pos2.setProperty(Position::Dotted);
+        staff.getVoices()[0].insertPosition(pos2);
+        staff.getVoices()[1].insertPosition(Position(5, Position::HalfNote));
+        system.insertStaff(staff);
+        score.insertSystem(system);
+    }
+    {
+        System system;
+        Staff staff(6);
+        staff.getVoices()[1].insertPosition(Position(1, Position::WholeNote));
+        system.insertStaff(staff);
+        system.insertStaff(staff);
+        score.insertSystem(system);
+    }
+
+    ScoreView view(score);
+
+    const int voice = view.getVoiceIndex(0, 0, 0);
+    REQUIRE(view.getPositions(voice) == ScoreView::IndexRange(0, 2));
+    REQUIRE(view.getPositionLocation(1) == 8);
+    REQUIRE(view.getDuration(0) == Ticks::PER_QUARTER);
+    REQUIRE(view.getDuration(1) == Ticks::PER_QUARTER * 3 / 4);
+
+    REQUIRE(view.getNotes(0) == ScoreView::IndexRange(0, 2));
+    REQUIRE(view.getNotes(1) == ScoreView::IndexRange(2, 2));
+    REQUIRE(view.getNoteString(1) == 4);
+    REQUIRE(view.getNoteFret(1) == 7);
+    REQUIRE(&view.getNote(0) ==
+            &score.getSystems()[0].getStaves()[0].getVoices()[0]
+                 .getPositions()[0].getNotes()[0]);
+
+    REQUIRE(view.findPositionsInRange(voice, 4, 10) ==
+            ScoreView::IndexRange(1, 2));
+    REQUIRE(view.findPosition(voice, 8) == 1);
+    REQUIRE(view.findPosition(voice, 5) == -1);
+
+    const int lastVoice = view.getVoiceIndex(1, 1, 1);
+    REQUIRE(view.getPositions(lastVoice) == ScoreView::IndexRange(4, 5));
+    REQUIRE(view.getDuration(4) == 4 * Ticks::PER_QUARTER);
+}
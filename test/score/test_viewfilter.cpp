@@ -67,3 +67,64 @@ TEST_CASE("Score/ViewFilter/Serialization", "")
 
     Serialization::test("filter", filter);
 }
+
+TEST_CASE("Score/ViewFilter/LoadedRule", "")
+{
+    Score score;
+
+    PowerTabImporter importer;
+    importer.load(AppInfo::getAbsolutePath("data/test_viewfilter.pt2"), score);
+
+    // A rule that is loaded from a file should use the loaded regex.
+    std::ostringstream output;
+    ScoreUtils::save(output, "rule",
+                     FilterRule(FilterRule::PLAYER_NAME, "Player [12]"));
+
+    FilterRule rule;
+    std::istringstream input(output.str());
+    ScoreUtils::load(input, "rule", rule);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        REQUIRE(rule.accept(score, 0, 0));
+        REQUIRE(rule.accept(score, 0, 1));
+        REQUIRE(!rule.accept(score, 0, 2));
+    }
+}
+
+TEST_CASE("Score/ViewFilter/CopiedRule", "")
+{
+    Score score;
+
+    PowerTabImporter importer;
+    importer.load(AppInfo::getAbsolutePath("data/test_viewfilter.pt2"), score);
+
+    // Each copy of a rule matches names against its own pattern.
+    FilterRule rule1(FilterRule::PLAYER_NAME, "Player [12]");
+    REQUIRE(!rule1.accept(score, 0, 2));
+
+    std::ostringstream output;
+    ScoreUtils::save(output, "rule", FilterRule(FilterRule::PLAYER_NAME, ".*"));
+
+    FilterRule rule2(rule1);
+    std::istringstream input(output.str());
+    ScoreUtils::load(input, "rule", rule2);
+
+    REQUIRE(!rule1.accept(score, 0, 2));
+    REQUIRE(rule2.accept(score, 0, 2));
+}
+
+TEST_CASE("Score/ViewFilter/InvalidRegex", "")
+{
+    std::ostringstream output;
+    ScoreUtils::save(output, "rule",
+                     FilterRule(FilterRule::PLAYER_NAME, "Player 1"));
+
+    // An invalid regex should be reported when the file is loaded.
+    std::string data = output.str();
+    data.replace(data.find("Player 1"), 8, "Player [");
+
+    FilterRule rule;
+    std::istringstream input(data);
+    REQUIRE_THROWS(ScoreUtils::load(input, "rule", rule));
+}
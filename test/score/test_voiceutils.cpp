@@ -17,6 +17,7 @@
   
 #include <catch.hpp>
 
+#include <score/voicedurations.h>
 #include <score/voiceutils.h>
 #include <score/voice.h>
 
@@ -24,21 +25,72 @@ TEST_CASE("Score/VoiceUtils/GetDurationTime", "")
 {
     Voice voice;
     voice.insertPosition(Position(7));
-    Position &position = voice.getPositions().front();
+    const Voice &const_voice = voice;
+    const Position &position = const_voice.getPositions().front();
 
-    position.setDurationType(Position::QuarterNote);
+    voice.getPositions().front().setDurationType(Position::QuarterNote);
     REQUIRE(VoiceUtils::getDurationTime(voice, position) == 1);
 
-    position.setDurationType(Position::EighthNote);
+    voice.getPositions().front().setDurationType(Position::EighthNote);
     REQUIRE(VoiceUtils::getDurationTime(voice, position) ==
             boost::rational<int>(1, 2));
 
-    position.setDurationType(Position::WholeNote);
+    voice.getPositions().front().setDurationType(Position::WholeNote);
     REQUIRE(VoiceUtils::getDurationTime(voice, position) == 4);
 
-    position.setProperty(Position::Dotted);
+    voice.getPositions().front().setProperty(Position::Dotted);
     REQUIRE(VoiceUtils::getDurationTime(voice, position) == 6);
 
     voice.insertIrregularGrouping(IrregularGrouping(7, 1, 3, 2));
     REQUIRE(VoiceUtils::getDurationTime(voice, position) == 4);
+
+    // A copy of a position isn't part of the voice, so its duration is
+    // computed directly.
+    Position copy(position);
+    copy.setDurationType(Position::HalfNote);
+    REQUIRE(VoiceUtils::getDurationTime(voice, copy) == 2);
+}
+
+TEST_CASE("Score/VoiceUtils/VoiceDurations", "")
+{
+    Voice voice;
+    for (int i = 0; i < 5; ++i)
+    {
+        Position pos(i, Position::EighthNote);
+        voice.insertPosition(pos);
+    }
+    voice.getPositions()[0].setDurationType(Position::QuarterNote);
+    voice.getPositions()[1].setProperty(Position::Acciaccatura);
+    voice.insertIrregularGrouping(IrregularGrouping(2, 3, 3, 2));
+
+    auto durations = voice.getDurations();
+    REQUIRE(durations->getPositionCount() == 5);
+    REQUIRE(durations->getDuration(0) == Ticks::PER_QUARTER);
+    REQUIRE(durations->getDuration(1) == 0);
+    REQUIRE(durations->getDuration(2) == Ticks::PER_QUARTER / 3);
+    REQUIRE(durations->getStartTime(2) == Ticks::PER_QUARTER);
+    REQUIRE(durations->getStartTime(5) == 2 * Ticks::PER_QUARTER);
+
+    REQUIRE(durations->findPositionAt(-1) == -1);
+    REQUIRE(durations->findPositionAt(Ticks::PER_QUARTER / 2) == 0);
+    // The grace note has no duration, so the next position is found instead.
+    REQUIRE(durations->findPositionAt(Ticks::PER_QUARTER) == 2);
+    REQUIRE(durations->findPositionAt(Ticks::PER_QUARTER * 5 / 3) == 4);
+    REQUIRE(durations->findPositionAt(2 * Ticks::PER_QUARTER) == -1);
+
+    // The durations are shared until the voice is modified.
+    REQUIRE(voice.getDurations() == durations);
+
+    voice.insertPosition(Position(5, Position::QuarterNote));
+    REQUIRE(voice.getDurations() != durations);
+    REQUIRE(voice.getDurations()->getStartTime(6) == 3 * Ticks::PER_QUARTER);
+
+    // Modifying a position through the voice's non-const accessors also
+    // discards the durations.
+    durations = voice.getDurations();
+    voice.getPositions()[5].setProperty(Position::Dotted);
+    REQUIRE(voice.getDurations()->getStartTime(6) ==
+            Ticks::PER_QUARTER * 7 / 2);
+    REQUIRE(*voice.getDurations() == VoiceDurations(voice));
+    REQUIRE(!(*durations == VoiceDurations(voice)));
 }